@@ -13,6 +13,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "async_logger.h"
+
 using namespace std;
 
 std::string TICKER = "BTC"; // ticker for the crypto we are trading
@@ -111,17 +113,17 @@ private:
                     users[userId1].user_balance.balance[TICKER] += quantity;
                     users[userId2].user_balance.balance["USD"] += price * quantity;
                     users[userId2].user_balance.balance[TICKER] -= quantity;
-                    cout << "Funds and BTC transferred!" << endl;
+                    OB_LOG_INFO("Funds and BTC transferred!");
                     // Log the trade
                     trade_history.emplace_back(userId1, userId2, price, quantity);
                 } else {
-                    cout << "User does not have enough BTC to sell" << endl;
+                    OB_LOG_WARN("User does not have enough BTC to sell");
                 }
             } else {
-                cout << "User does not have enough USD to buy BTC" << endl;
+                OB_LOG_WARN("User does not have enough USD to buy BTC");
             }
         } else {
-            cout << "One or both users not found" << endl;
+            OB_LOG_WARN("One or both users not found");
         }
     }
 
@@ -182,7 +184,7 @@ public:
     std::string makeUser(std::string Username) {
         User user(Username);
         users[Username] = user;
-        cout << "User: " << Username << " created successfully for BTC trading" << endl;
+        OB_LOG_INFO("User: %s created successfully for BTC trading", Username);
         return "User created successfully";
     }
 
@@ -198,13 +200,13 @@ public:
                 if (it->quantity > remQty) {
                     it->quantity -= remQty;
                     flipBalance(Username, it->user_name, remQty, it->price);
-                    cout << "Bid Satisfied Successfully at price: " << it->price << " and quantity: " << remQty << " BTC" << endl;
+                    OB_LOG_INFO("Bid Satisfied Successfully at price: %g and quantity: %g BTC", it->price, remQty);
                     remQty = 0;
                     break;
                 } else {
                     remQty -= it->quantity;
                     flipBalance(Username, it->user_name, it->quantity, it->price);
-                    cout << "Bid Satisfied Partially at price: " << it->price << " and quantity: " << it->quantity << " BTC" << endl;
+                    OB_LOG_INFO("Bid Satisfied Partially at price: %g and quantity: %g BTC", it->price, it->quantity);
                     it = asks.erase(it);
                 }
             } else {
@@ -215,11 +217,11 @@ public:
         if (remQty > 0) {
             Order bid(Username, "bid", Price, remQty);
             bids.push_back(bid);
-            cout << "Remaining quantity of bids added to Orderbook (Order ID: " << bid.order_id << ")" << endl;
+            OB_LOG_INFO("Remaining quantity of bids added to Orderbook (Order ID: %lld)", bid.order_id);
         }
 
         if (remQty == 0) {
-            cout << "Complete Bid Satisfied Successfully" << endl;
+            OB_LOG_INFO("Complete Bid Satisfied Successfully");
         }
         return "Bid added/satisfied successfully.";
     }
@@ -236,13 +238,13 @@ public:
                 if (it->quantity > remQty) {
                     it->quantity -= remQty;
                     flipBalance(it->user_name, Username, remQty, it->price);
-                    cout << "Ask Satisfied Successfully at price: " << it->price << " and quantity: " << remQty << " BTC" << endl;
+                    OB_LOG_INFO("Ask Satisfied Successfully at price: %g and quantity: %g BTC", it->price, remQty);
                     remQty = 0;
                     break;
                 } else {
                     remQty -= it->quantity;
                     flipBalance(it->user_name, Username, it->quantity, it->price);
-                    cout << "Ask Satisfied Partially at price: " << it->price << " and quantity: " << it->quantity << " BTC" << endl;
+                    OB_LOG_INFO("Ask Satisfied Partially at price: %g and quantity: %g BTC", it->price, it->quantity);
                     it = bids.erase(it);
                 }
             } else {
@@ -253,11 +255,11 @@ public:
         if (remQty > 0) {
             Order ask(Username, "ask", Price, remQty);
             asks.push_back(ask);
-            cout << "Remaining quantity of asks added to Orderbook (Order ID: " << ask.order_id << ")" << endl;
+            OB_LOG_INFO("Remaining quantity of asks added to Orderbook (Order ID: %lld)", ask.order_id);
         }
 
         if (remQty == 0) {
-            cout << "Complete Ask Satisfied Successfully" << endl;
+            OB_LOG_INFO("Complete Ask Satisfied Successfully");
         }
         return "Ask added successfully.";
     }
@@ -272,20 +274,20 @@ public:
             if (it->quantity > remQty) {
                 it->quantity -= remQty;
                 flipBalance(Username, it->user_name, remQty, it->price);
-                cout << "Market Bid Satisfied at price: " << it->price << " and quantity: " << remQty << " BTC" << endl;
+                OB_LOG_INFO("Market Bid Satisfied at price: %g and quantity: %g BTC", it->price, remQty);
                 remQty = 0;
             } else {
                 remQty -= it->quantity;
                 flipBalance(Username, it->user_name, it->quantity, it->price);
-                cout << "Market Bid Satisfied Partially at price: " << it->price << " and quantity: " << it->quantity << " BTC" << endl;
+                OB_LOG_INFO("Market Bid Satisfied Partially at price: %g and quantity: %g BTC", it->price, it->quantity);
                 it = asks.erase(it);
             }
         }
 
         if (remQty > 0) {
-            cout << "Insufficient liquidity to fill market bid. Remaining: " << remQty << " BTC" << endl;
+            OB_LOG_WARN("Insufficient liquidity to fill market bid. Remaining: %g BTC", remQty);
         } else {
-            cout << "Market Bid Filled Successfully" << endl;
+            OB_LOG_INFO("Market Bid Filled Successfully");
         }
         return "Market bid processed.";
     }
@@ -300,25 +302,26 @@ public:
             if (it->quantity > remQty) {
                 it->quantity -= remQty;
                 flipBalance(it->user_name, Username, remQty, it->price);
-                cout << "Market Ask Satisfied at price: " << it->price << " and quantity: " << remQty << " BTC" << endl;
+                OB_LOG_INFO("Market Ask Satisfied at price: %g and quantity: %g BTC", it->price, remQty);
                 remQty = 0;
             } else {
                 remQty -= it->quantity;
                 flipBalance(it->user_name, Username, it->quantity, it->price);
-                cout << "Market Ask Satisfied Partially at price: " << it->price << " and quantity: " << it->quantity << " BTC" << endl;
+                OB_LOG_INFO("Market Ask Satisfied Partially at price: %g and quantity: %g BTC", it->price, it->quantity);
                 it = bids.erase(it);
             }
         }
 
         if (remQty > 0) {
-            cout << "Insufficient liquidity to fill market ask. Remaining: " << remQty << " BTC" << endl;
+            OB_LOG_WARN("Insufficient liquidity to fill market ask. Remaining: %g BTC", remQty);
         } else {
-            cout << "Market Ask Filled Successfully" << endl;
+            OB_LOG_INFO("Market Ask Filled Successfully");
         }
         return "Market ask processed.";
     }
 
     std::string getBalance(std::string username) {
+        oblog::flush();
         if (users.find(username) != users.end()) {
             cout << "User found" << endl;
             cout << "User balance is as follows: " << endl;
@@ -333,6 +336,7 @@ public:
     }
 
     std::string getQuote(double qty) {
+        oblog::flush();
         std::stable_sort(asks.begin(), asks.end(), [](const Order &a, const Order &b) {
             if (a.price == b.price) return a.insertion_order_ask < b.insertion_order_ask;
             return a.price < b.price;
@@ -354,6 +358,7 @@ public:
     }
 
     std::string getDepth() {
+        oblog::flush();
         std::sort(asks.begin(), asks.end(), [](const Order &a, const Order &b) {
             return a.price > b.price;
         });
@@ -388,10 +393,10 @@ public:
     std::string addBalanace(std::string Username, std::string market, double value) {
         if (users.find(Username) != users.end()) {
             users[Username].user_balance.addBalance(market, value);
-            cout << "Balance added successfully" << endl;
+            OB_LOG_INFO("Balance added successfully");
             return "Balance added successfully";
         }
-        cout << "User not found!! Please enter the right Username to add balance!" << endl;
+        OB_LOG_WARN("User not found!! Please enter the right Username to add balance!");
         return "User not found";
     }
 
@@ -399,51 +404,52 @@ public:
         for (auto it = asks.begin(); it != asks.end(); ++it) {
             if (OrderId != -1 && it->order_id == OrderId && it->user_name == Username) {
                 asks.erase(it);
-                cout << "Ask cancelled successfully (Order ID: " << OrderId << ")" << endl;
+                OB_LOG_INFO("Ask cancelled successfully (Order ID: %lld)", OrderId);
                 return;
             } else if (OrderId == -1 && it->user_name == Username && it->price == Price) {
                 if (it->quantity == Quantity) {
                     asks.erase(it);
-                    cout << "Ask cancelled successfully" << endl;
+                    OB_LOG_INFO("Ask cancelled successfully");
                     return;
                 } else if (it->quantity > Quantity) {
                     it->quantity -= Quantity;
-                    cout << "Ask partially cancelled successfully" << endl;
+                    OB_LOG_INFO("Ask partially cancelled successfully");
                     return;
                 } else {
-                    cout << "Ask quantity is less than the quantity you want to cancel" << endl;
+                    OB_LOG_WARN("Ask quantity is less than the quantity you want to cancel");
                     return;
                 }
             }
         }
-        cout << "Ask not found!! Please enter the right Username, Order ID, Price, and Quantity!" << endl;
+        OB_LOG_WARN("Ask not found!! Please enter the right Username, Order ID, Price, and Quantity!");
     }
 
     void cancelBid(std::string Username, long long OrderId = -1, double Price = 0, double Quantity = 0) {
         for (auto it = bids.begin(); it != bids.end(); ++it) {
             if (OrderId != -1 && it->order_id == OrderId && it->user_name == Username) {
                 bids.erase(it);
-                cout << "Bid cancelled successfully (Order ID: " << OrderId << ")" << endl;
+                OB_LOG_INFO("Bid cancelled successfully (Order ID: %lld)", OrderId);
                 return;
             } else if (OrderId == -1 && it->user_name == Username && it->price == Price) {
                 if (it->quantity == Quantity) {
                     bids.erase(it);
-                    cout << "Bid cancelled successfully" << endl;
+                    OB_LOG_INFO("Bid cancelled successfully");
                     return;
                 } else if (it->quantity > Quantity) {
                     it->quantity -= Quantity;
-                    cout << "Bid partially cancelled successfully" << endl;
+                    OB_LOG_INFO("Bid partially cancelled successfully");
                     return;
                 } else {
-                    cout << "Bid quantity is less than the quantity you want to cancel" << endl;
+                    OB_LOG_WARN("Bid quantity is less than the quantity you want to cancel");
                     return;
                 }
             }
         }
-        cout << "Bid not found!! Please enter the right Username, Order ID, Price, and Quantity!" << endl;
+        OB_LOG_WARN("Bid not found!! Please enter the right Username, Order ID, Price, and Quantity!");
     }
 
     std::string getTradeHistory() {
+        oblog::flush();
         if (trade_history.empty()) {
             cout << "No trades have occurred yet." << endl;
             return "No trades";
@@ -460,6 +466,7 @@ public:
     }
 
     std::string getSpread() {
+        oblog::flush();
         if (bids.empty() || asks.empty()) {
             cout << "Insufficient data to calculate spread." << endl;
             return "No spread available";
@@ -491,6 +498,7 @@ int main() {
     EXCH.getDepth();
 
     while (true) {
+        oblog::flush();
         cout << "\n=========== " << TICKER << " Trading Platform ===========\n\n";
         cout << "1. Sign Up User\n";
         cout << "2. Add Balance to User Account\n";
@@ -0,0 +1,315 @@
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+// Asynchronous binary logger. A log call stores a pointer to its static call
+// site (level + printf-style format) and the raw argument values in a
+// fixed-size record on the calling thread's SPSC ring; a background thread
+// formats and writes the records. The calling thread never formats, allocates
+// or flushes.
+//
+// Severity is a compile-time setting: calls below OB_LOG_LEVEL expand to
+// nothing. A full ring drops the record and counts it instead of blocking.
+//
+//   OB_LOG_INFO("Order %d filled at %.2f", id, price);
+//   oblog::flush(); // before writing to stdout directly
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "spsc_ring.h"
+
+#define OB_LEVEL_DEBUG 0
+#define OB_LEVEL_INFO 1
+#define OB_LEVEL_WARN 2
+#define OB_LEVEL_ERROR 3
+#define OB_LEVEL_OFF 4
+
+#ifndef OB_LOG_LEVEL
+#define OB_LOG_LEVEL OB_LEVEL_DEBUG
+#endif
+
+#ifndef OB_LOG_RING_RECORDS
+#define OB_LOG_RING_RECORDS 16384 // per producing thread, 256 bytes each
+#endif
+
+namespace oblog {
+
+struct LogSite {
+    int level;
+    const char* format;
+};
+
+constexpr size_t RECORD_SIZE = 256;
+constexpr size_t STRING_CAPACITY = 48; // longer strings are truncated
+constexpr size_t LINE_SIZE = 1024;
+
+// Strings are copied into the record since the caller's buffer may not outlive it.
+struct InlineString {
+    char text[STRING_CAPACITY];
+};
+
+template <typename T, typename = void>
+struct ArgTraits {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "log arguments must be numbers or strings");
+    using Stored = T;
+    static Stored store(T value) { return value; }
+    static T load(const Stored& value) { return value; }
+};
+
+template <typename T>
+struct ArgTraits<T, std::enable_if_t<std::is_convertible_v<const T&, std::string_view>>> {
+    using Stored = InlineString;
+    static Stored store(std::string_view value) {
+        Stored out;
+        size_t n = std::min(value.size(), STRING_CAPACITY - 1);
+        std::memcpy(out.text, value.data(), n);
+        out.text[n] = '\0';
+        return out;
+    }
+    static const char* load(const Stored& value) { return value.text; }
+};
+
+// Arguments are packed back to back in call order.
+template <typename... Args>
+constexpr size_t payloadSize() { return (size_t(0) + ... + sizeof(typename ArgTraits<Args>::Stored)); }
+
+using Formatter = int (*)(const char* format, const unsigned char* args, char* out, size_t size);
+
+struct Record {
+    const LogSite* site;
+    Formatter formatter;
+    int64_t timestamp; // steady clock, ns
+    alignas(8) unsigned char args[RECORD_SIZE - 3 * sizeof(int64_t)];
+};
+static_assert(sizeof(Record) == RECORD_SIZE);
+
+template <typename... Args, size_t... I>
+int formatArgs(const char* format, const std::tuple<typename ArgTraits<Args>::Stored...>& values,
+               char* out, size_t size, std::index_sequence<I...>) {
+    return std::snprintf(out, size, format, ArgTraits<Args>::load(std::get<I>(values))...);
+}
+
+// Runs on the writer thread; instantiated once per argument-type list.
+template <typename... Args>
+int formatRecord(const char* format, const unsigned char* args, char* out, size_t size) {
+    if constexpr (sizeof...(Args) == 0) {
+        return std::snprintf(out, size, "%s", format);
+    } else {
+        std::tuple<typename ArgTraits<Args>::Stored...> values;
+        std::apply([&](auto&... value) { ((std::memcpy(&value, args, sizeof(value)), args += sizeof(value)), ...); },
+                   values);
+        return formatArgs<Args...>(format, values, out, size, std::index_sequence_for<Args...>{});
+    }
+}
+
+// Set while this thread's log calls should be dropped; see ThreadMute.
+inline thread_local bool threadMuted = false;
+
+class Logger {
+private:
+    struct Producer {
+        SpscRing<Record> ring{OB_LOG_RING_RECORDS};
+    };
+
+    std::mutex producersMutex; // registration and the writer's snapshot only
+    std::vector<std::unique_ptr<Producer>> producers;
+    std::atomic<uint64_t> droppedCount{0};
+    std::atomic<uint64_t> flushRequests{0};
+    std::atomic<uint64_t> flushesDone{0};
+    std::atomic<bool> stopping{false};
+    std::FILE* out = stdout;
+    std::thread writer;
+
+    Logger() : writer([this] { run(); }) {}
+
+    ~Logger() {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+
+    Producer& local() {
+        thread_local Producer* producer = nullptr;
+        if (!producer) {
+            std::lock_guard<std::mutex> lock(producersMutex);
+            producers.push_back(std::make_unique<Producer>());
+            producer = producers.back().get();
+        }
+        return *producer;
+    }
+
+    template <typename Stored>
+    static void pack(unsigned char*& payload, const Stored& value) {
+        static_assert(std::is_trivially_copyable_v<Stored>);
+        std::memcpy(payload, &value, sizeof(value));
+        payload += sizeof(value);
+    }
+
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Writes everything currently queued, oldest record first across threads.
+    size_t drain(std::vector<Producer*>& active, char* line) {
+        {
+            std::lock_guard<std::mutex> lock(producersMutex);
+            active.clear();
+            for (auto& producer : producers) active.push_back(producer.get());
+        }
+        size_t written = 0;
+        while (true) {
+            Producer* from = nullptr;
+            Record* next = nullptr;
+            for (Producer* producer : active) {
+                Record* record = producer->ring.peek();
+                if (record && (!next || record->timestamp < next->timestamp)) {
+                    next = record;
+                    from = producer;
+                }
+            }
+            if (!next) return written;
+            int len = next->formatter(next->site->format, next->args, line, LINE_SIZE);
+            if (len > 0) std::fwrite(line, 1, std::min<size_t>(size_t(len), LINE_SIZE - 1), out);
+            std::fputc('\n', out);
+            from->ring.release();
+            ++written;
+        }
+    }
+
+    void run() {
+        std::vector<Producer*> active;
+        std::unique_ptr<char[]> line(new char[LINE_SIZE]);
+        while (true) {
+            bool stop = stopping.load(std::memory_order_acquire);
+            uint64_t requested = flushRequests.load(std::memory_order_acquire);
+            size_t written = drain(active, line.get());
+            if (requested > flushesDone.load(std::memory_order_relaxed)) {
+                std::fflush(out);
+                flushesDone.store(requested, std::memory_order_release);
+            }
+            if (stop && written == 0) break;
+            if (written == 0) std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        std::fflush(out);
+    }
+
+public:
+    static Logger& instance() {
+        static Logger logger;
+        return logger;
+    }
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    template <typename... Args>
+    void write(const LogSite& site, const Args&... args) {
+        static_assert(payloadSize<std::decay_t<Args>...>() <= sizeof(Record::args),
+                      "too many log arguments for one record");
+
+        if (threadMuted) return;
+        Producer& producer = local();
+        Record* record = producer.ring.claim();
+        if (!record) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        record->site = &site;
+        record->formatter = &formatRecord<std::decay_t<Args>...>;
+        record->timestamp = now();
+        [[maybe_unused]] unsigned char* payload = record->args;
+        ((pack(payload, ArgTraits<std::decay_t<Args>>::store(args))), ...);
+        producer.ring.publish();
+    }
+
+    // Blocks until every record this thread has logged so far is written out.
+    void flush() {
+        uint64_t ticket = flushRequests.fetch_add(1, std::memory_order_acq_rel) + 1;
+        while (flushesDone.load(std::memory_order_acquire) < ticket) std::this_thread::yield();
+    }
+
+    // Call before anything is logged.
+    void setOutput(std::FILE* file) { out = file; }
+
+    uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+};
+
+// Drops the calling thread's log calls while alive, e.g. around a book
+// re-running another book's commands, which would repeat its log lines.
+class ThreadMute {
+private:
+    bool saved = threadMuted;
+
+public:
+    ThreadMute() { threadMuted = true; }
+    ~ThreadMute() { threadMuted = saved; }
+    ThreadMute(const ThreadMute&) = delete;
+    ThreadMute& operator=(const ThreadMute&) = delete;
+};
+
+inline void flush() {
+#if OB_LOG_LEVEL < OB_LEVEL_OFF
+    Logger::instance().flush();
+#endif
+}
+
+inline uint64_t dropped() {
+#if OB_LOG_LEVEL < OB_LEVEL_OFF
+    return Logger::instance().dropped();
+#else
+    return 0;
+#endif
+}
+
+// Names the arguments of a compiled-out log call without evaluating them, so
+// values only read for logging do not trigger unused warnings.
+template <typename... Args>
+constexpr int discard(const Args&...) { return 0; }
+
+} // namespace oblog
+
+#define OB_LOG_DISCARD(...) ((void)sizeof(::oblog::discard(__VA_ARGS__)))
+
+#define OB_LOG(level, fmt, ...)                                                              \
+    do {                                                                                     \
+        static constexpr ::oblog::LogSite obLogSite{(level), fmt};                           \
+        ::oblog::Logger::instance().write(obLogSite __VA_OPT__(, ) __VA_ARGS__);             \
+    } while (0)
+
+#if OB_LOG_LEVEL <= OB_LEVEL_DEBUG
+#define OB_LOG_DEBUG(...) OB_LOG(OB_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define OB_LOG_DEBUG(...) OB_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if OB_LOG_LEVEL <= OB_LEVEL_INFO
+#define OB_LOG_INFO(...) OB_LOG(OB_LEVEL_INFO, __VA_ARGS__)
+#else
+#define OB_LOG_INFO(...) OB_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if OB_LOG_LEVEL <= OB_LEVEL_WARN
+#define OB_LOG_WARN(...) OB_LOG(OB_LEVEL_WARN, __VA_ARGS__)
+#else
+#define OB_LOG_WARN(...) OB_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if OB_LOG_LEVEL <= OB_LEVEL_ERROR
+#define OB_LOG_ERROR(...) OB_LOG(OB_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define OB_LOG_ERROR(...) OB_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#endif
@@ -0,0 +1,139 @@
+// bench_analytics.cpp
+// Measures the incremental trade analytics: the matching cost with analytics
+// attached against without, then a synthetic 6.5 hour session fed straight to
+// TradeAnalytics (publishing after every trade) while a chart thread drains
+// completed bars and a dashboard thread reads snapshots. Compares one
+// snapshot read with what a dashboard refresh costs when it recomputes the
+// session VWAP, the open 1m bar and the 5m rolling volume from the full trade
+// list, and checks both give the same numbers.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_analytics.cpp -o bench_analytics -pthread
+
+#include "exchange_orderbook.h"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+const int NUM_COMMANDS = 200000;
+const int SESSION_TRADES = 2000000;
+const int64_t SESSION_NS = int64_t(6.5 * 3600) * 1000000000;
+
+struct SessionTrade {
+    int64_t time;
+    int64_t price;
+    int64_t qty;
+};
+
+double runFlow(OrderBook& ob) {
+    mt19937_64 rng(3);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 10) - 5) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        if (rng() % 8 == 0) ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, "Taker");
+        else ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, buy ? "Bidder" : "Seller");
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    return double(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / NUM_COMMANDS;
+}
+
+int main() {
+    PoolConfig pools{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS)};
+    OrderBook plain(pools);
+    plain.setTickSize(0.01, 0.001);
+    double plainNs = runFlow(plain);
+
+    OrderBook ob(pools);
+    ob.setTickSize(0.01, 0.001);
+    TradeAnalytics live;
+    ob.attachAnalytics(&live);
+    double analyticsNs = runFlow(ob);
+
+    // Synthetic session: a random walk with trades at random times.
+    mt19937_64 rng(9);
+    vector<SessionTrade> trades(SESSION_TRADES);
+    int64_t open = chrono::duration_cast<chrono::nanoseconds>(chrono::hours(24 * 20000 + 14)).count();
+    int64_t price = 6741600;
+    for (int i = 0; i < SESSION_TRADES; ++i) {
+        price += int64_t(rng() % 5) - 2;
+        trades[i] = {open + int64_t(rng() % uint64_t(SESSION_NS)), price, int64_t(1 + rng() % 100)};
+    }
+    sort(trades.begin(), trades.end(), [](const SessionTrade& a, const SessionTrade& b) { return a.time < b.time; });
+
+    TradeAnalytics analytics;
+    atomic<bool> done{false};
+    uint64_t barsPolled[MAX_BAR_INTERVALS] = {};
+    uint64_t snapshotsRead = 0, inconsistent = 0;
+    thread chart([&] {
+        Bar bar;
+        while (true) {
+            bool finished = done.load(memory_order_acquire);
+            bool any = false;
+            while (analytics.pollBar(bar)) {
+                barsPolled[bar.interval]++;
+                any = true;
+            }
+            if (finished && !any) break;
+            this_thread::yield();
+        }
+    });
+    thread dashboard([&] {
+        while (!done.load(memory_order_relaxed)) {
+            AnalyticsSnapshot s = analytics.read();
+            snapshotsRead++;
+            if (s.trades && (s.low > s.last || s.high < s.last || s.rolling[0].volume > s.volume)) inconsistent++;
+            this_thread::yield();
+        }
+    });
+
+    auto start = chrono::steady_clock::now();
+    for (const SessionTrade& t : trades) {
+        analytics.onTrade(t.time, t.price, t.qty);
+        analytics.publish(t.time);
+    }
+    double perTrade = double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) /
+                      SESSION_TRADES;
+    done.store(true, memory_order_release);
+    chart.join();
+    dashboard.join();
+
+    start = chrono::steady_clock::now();
+    AnalyticsSnapshot s = analytics.read();
+    double readNs = double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+    // What a dashboard refresh does without the analytics.
+    start = chrono::steady_clock::now();
+    int64_t volume = 0, notional = 0, barVolume = 0, rollingVolume = 0;
+    int64_t minute = chrono::duration_cast<chrono::nanoseconds>(chrono::minutes(1)).count();
+    int64_t barStart = trades.back().time - trades.back().time % minute;
+    int64_t rollingFrom = s.rolling[1].end - s.rolling[1].length;
+    for (const SessionTrade& t : trades) {
+        volume += t.qty;
+        notional += t.price * t.qty;
+        if (t.time >= barStart) barVolume += t.qty;
+        if (t.time >= rollingFrom) rollingVolume += t.qty;
+    }
+    double recomputeUs =
+        double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / 1000.0;
+    bool match = volume == s.volume && notional == s.notional && barVolume == s.current[1].volume &&
+                 barStart == s.current[1].start && rollingVolume == s.rolling[1].volume;
+
+    const AnalyticsStats& stats = analytics.getStats();
+    oblog::flush();
+    cout << fixed << setprecision(1) << "Trade analytics\n"
+         << "  matching, " << NUM_COMMANDS << " commands      " << plainNs << " ns/command without, " << analyticsNs
+         << " with (" << live.getStats().trades << " trades)\n"
+         << "  session, " << SESSION_TRADES << " trades over 6.5h  " << perTrade << " ns/trade incl. publish, "
+         << stats.published << " snapshots published\n"
+         << "  bars completed " << stats.barsCompleted << " (1s " << barsPolled[0] << ", 1m " << barsPolled[1]
+         << ", 5m " << barsPolled[2] << " polled, " << stats.barsDropped << " dropped)\n"
+         << "  dashboard thread read " << snapshotsRead << " snapshots, " << inconsistent << " inconsistent\n"
+         << "  refresh: snapshot read " << readNs << " ns, recompute from trades " << recomputeUs << " us ("
+         << (match ? "same numbers" : "MISMATCH") << ")\n"
+         << setprecision(2) << "  session VWAP " << s.vwap() / 100.0 << ", 5m rolling volume " << s.rolling[1].volume
+         << " lots, last 1m bar O " << s.current[1].open / 100.0 << " H " << s.current[1].high / 100.0 << " L "
+         << s.current[1].low / 100.0 << " C " << s.current[1].close / 100.0 << endl;
+    return match && inconsistent == 0 ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+// bench_batch.cpp
+// Order entry one call at a time (placeOrder / cancelOrder) against bursts of
+// BURST through placeOrders / cancelOrders, on the same flow of limit orders
+// around a fixed mid. Reports nanoseconds per order for each.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_batch.cpp -o bench_batch -pthread
+
+#include "exchange_orderbook.h"
+
+#include <cstdio>
+#include <random>
+
+const int NUM_ORDERS = 200000;
+const size_t BURST = 64;
+
+vector<OrderRequest> makeFlow() {
+    mt19937_64 rng(11);
+    vector<OrderRequest> flow;
+    flow.reserve(NUM_ORDERS);
+    for (int i = 0; i < NUM_ORDERS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 40) - 20) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        flow.push_back({buy ? "buy" : "sell", price, qty, LIMIT, buy ? "Bidder" : "Seller"});
+    }
+    return flow;
+}
+
+double nanosPer(chrono::steady_clock::duration d, size_t n) {
+    return double(chrono::duration_cast<chrono::nanoseconds>(d).count()) / double(n);
+}
+
+int main() {
+    vector<OrderRequest> flow = makeFlow();
+    vector<int> single(flow.size()), batched(flow.size());
+    PoolConfig pools{.orderCapacity = size_t(NUM_ORDERS), .tradeCapacity = size_t(NUM_ORDERS)};
+
+    OrderBook a(pools);
+    a.setTickSize(0.01, 0.001);
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < flow.size(); ++i) {
+        const OrderRequest& r = flow[i];
+        single[i] = a.placeOrder(r.side, r.price, r.quantity, r.type, r.clientId);
+    }
+    double placeSingle = nanosPer(chrono::steady_clock::now() - start, flow.size());
+    start = chrono::steady_clock::now();
+    for (int id : single) a.cancelOrder(id);
+    double cancelSingle = nanosPer(chrono::steady_clock::now() - start, flow.size());
+
+    OrderBook b(pools);
+    b.setTickSize(0.01, 0.001);
+    span<const OrderRequest> requests(flow);
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < flow.size(); i += BURST) {
+        size_t n = min(BURST, flow.size() - i);
+        b.placeOrders(requests.subspan(i, n), span<int>(batched).subspan(i, n));
+    }
+    double placeBatched = nanosPer(chrono::steady_clock::now() - start, flow.size());
+    bool cancelled[BURST];
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < batched.size(); i += BURST) {
+        size_t n = min(BURST, batched.size() - i);
+        b.cancelOrders(span<const int>(batched).subspan(i, n), span<bool>(cancelled, n));
+    }
+    double cancelBatched = nanosPer(chrono::steady_clock::now() - start, flow.size());
+
+    oblog::flush();
+    cout << fixed << setprecision(1) << "Order entry, " << NUM_ORDERS << " orders (ns/order):\n"
+         << "  placeOrder   " << placeSingle << " | placeOrders  (burst " << BURST << ") " << placeBatched << "\n"
+         << "  cancelOrder  " << cancelSingle << " | cancelOrders (burst " << BURST << ") " << cancelBatched << "\n"
+         << "  same order IDs: " << (single == batched ? "yes" : "NO") << endl;
+    return single == batched ? 0 : 1;
+}
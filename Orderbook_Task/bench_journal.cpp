@@ -0,0 +1,93 @@
+// bench_journal.cpp
+// Records a workload to the command journal, then replays it into a fresh book
+// and checks both books end up identical. Reports the per-command latency with
+// journaling on (commits run on the journal's flusher thread), how far the
+// durable seq trailed the last command when the run ended, and the replay rate. Build with logging compiled out:
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_journal.cpp -o bench_journal -pthread
+
+#include "exchange_orderbook.h"
+
+#include <cstdio>
+#include <random>
+
+const int NUM_COMMANDS = 200000;
+const char* JOURNAL_PATH = "bench.journal";
+
+// Same shape as bench_logging: limit orders around a fixed mid, with every
+// fourth command a cancel, plus the odd modify and market order.
+void runWorkload(OrderBook& ob, vector<int64_t>& latencies) {
+    mt19937_64 rng(7);
+    vector<int> placed;
+    placed.reserve(NUM_COMMANDS);
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 40) - 20) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        uint64_t kind = rng() % 16;
+
+        auto start = chrono::steady_clock::now();
+        if (kind < 4 && !placed.empty()) ob.cancelOrder(placed[rng() % placed.size()]);
+        else if (kind == 4 && !placed.empty()) ob.modifyOrder(placed[rng() % placed.size()], price, qty);
+        else if (kind == 5) ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, "Taker");
+        else placed.push_back(ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, buy ? "Bidder" : "Seller"));
+        auto end = chrono::steady_clock::now();
+        latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+    }
+}
+
+bool sameBook(OrderBook& a, OrderBook& b) {
+    vector<DepthLevel> da(1000), db(1000);
+    for (const char* side : {"buy", "sell"}) {
+        size_t na = a.getDepth(side, da.data(), da.size());
+        size_t nb = b.getDepth(side, db.data(), db.size());
+        if (na != nb) return false;
+        for (size_t i = 0; i < na; ++i) {
+            if (da[i].price != db[i].price || da[i].quantity != db[i].quantity || da[i].orders != db[i].orders)
+                return false;
+        }
+    }
+    return a.getOrderPoolStats().inUse == b.getOrderPoolStats().inUse &&
+           a.getTradePoolStats().inUse == b.getTradePoolStats().inUse;
+}
+
+int main() {
+    remove(JOURNAL_PATH);
+    PoolConfig pools{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS) * 2};
+
+    OrderBook live(pools);
+    vector<int64_t> latencies;
+    latencies.reserve(NUM_COMMANDS);
+    JournalStats stats;
+    uint64_t durableAtEnd = 0;
+    {
+        CommandJournal journal(JOURNAL_PATH);
+        live.attachJournal(&journal);
+        live.setTickSize(0.01, 0.001);
+        runWorkload(live, latencies);
+        durableAtEnd = journal.durableSeq();
+        live.attachJournal(nullptr);
+        journal.sync();
+        stats = journal.getStats();
+    }
+
+    OrderBook replayed(pools);
+    auto start = chrono::steady_clock::now();
+    uint64_t applied = replayed.replayJournal(JOURNAL_PATH);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) { return latencies[size_t(p * (latencies.size() - 1))]; };
+    double mean = accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+
+    bool matches = sameBook(live, replayed);
+    oblog::flush();
+    cout << "Journaled: " << stats.records << " records, " << stats.syncs << " group commits | mean " << fixed
+         << setprecision(0) << mean << " ns | p50 " << pct(0.50) << " | p99 " << pct(0.99) << " | p99.9 "
+         << pct(0.999) << " | max " << latencies.back() << " ns | durable at end " << durableAtEnd << "/"
+         << stats.records << endl;
+    cout << "Replayed:  " << applied << " commands in " << setprecision(3) << seconds * 1e3 << " ms ("
+         << setprecision(0) << applied / seconds << " commands/s) | book "
+         << (matches ? "matches" : "DIFFERS") << endl;
+    remove(JOURNAL_PATH);
+    return matches ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+// bench_l3.cpp
+// Records the L3 order feed of a workload, then rebuilds the book from it with
+// L3BookBuilder. Reports the builder's cost per event, the heap allocations it
+// made while applying (operator new is counted) and whether checkL3Book finds
+// the rebuilt book identical to the engine's.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_l3.cpp -o bench_l3 -pthread
+
+#include "exchange_orderbook.h"
+#include "l3_book_builder.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+const int NUM_COMMANDS = 200000;
+
+static atomic<uint64_t> allocations{0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // new above is malloc
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#pragma GCC diagnostic pop
+
+int main() {
+    OrderBook ob(PoolConfig{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS)});
+    ob.setTickSize(0.01, 0.001);
+    OrderFeedPublisher feed(1 << 12);
+    ob.attachOrderFeed(&feed);
+
+    // Same flow as bench_journal; the feed is drained after every command.
+    vector<OrderEvent> events;
+    events.reserve(size_t(NUM_COMMANDS) * 4);
+    mt19937_64 rng(7);
+    vector<int> placed;
+    OrderEvent event;
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 40) - 20) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        uint64_t kind = rng() % 16;
+        if (kind < 4 && !placed.empty()) ob.cancelOrder(placed[rng() % placed.size()]);
+        else if (kind == 4 && !placed.empty()) ob.modifyOrder(placed[rng() % placed.size()], price, qty);
+        else if (kind == 5) ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, "Taker");
+        else placed.push_back(ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, buy ? "Bidder" : "Seller"));
+        while (feed.poll(event)) events.push_back(event);
+    }
+
+    // The first events place each side's ladder window around the market;
+    // that one-off setup is counted separately from the steady state.
+    const size_t WARMUP = 1000;
+    L3BookBuilder builder(L3BuilderConfig{size_t(NUM_COMMANDS), 4096});
+    uint64_t before = allocations.load();
+    for (size_t i = 0; i < WARMUP; ++i) builder.apply(events[i]);
+    uint64_t warmupAllocated = allocations.load() - before;
+    before = allocations.load();
+    auto start = chrono::steady_clock::now();
+    for (size_t i = WARMUP; i < events.size(); ++i) builder.apply(events[i]);
+    auto elapsed = chrono::steady_clock::now() - start;
+    uint64_t allocated = allocations.load() - before;
+
+    L3CheckResult check = checkL3Book(builder, ob);
+    double ns = double(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / double(events.size() - WARMUP);
+
+    oblog::flush();
+    cout << fixed << setprecision(1) << "L3 feed, " << NUM_COMMANDS << " commands -> " << events.size()
+         << " events (" << feed.getStats().dropped << " dropped)\n"
+         << "  builder apply   " << ns << " ns/event, " << allocated << " allocations (" << warmupAllocated
+         << " while placing the ladder windows in the first " << WARMUP << " events)\n"
+         << "  resting orders  " << builder.orderCount() << ", rejected events " << builder.getStats().rejected << "\n"
+         << "  checkL3Book     " << (check.consistent ? "consistent" : "MISMATCH: " + check.mismatch) << " ("
+         << check.ordersChecked << " orders compared)" << endl;
+    return check.consistent ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+// bench_latency.cpp
+// Measured stage latency of a mixed order flow, read from a second thread
+// while the engine runs: the reader polls the histograms without the matching
+// thread ever waiting on it. Also reports the calibrated TSC rate, the cost
+// of a timestamp and of a histogram record, and checks the histogram's
+// percentiles against exact ones on the same samples.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_latency.cpp -o bench_latency -pthread
+
+#include "exchange_orderbook.h"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+const int NUM_COMMANDS = 1000000;
+const int NUM_SAMPLES = 1000000;
+
+template <typename F>
+double nsPer(size_t n, F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / double(n);
+}
+
+int main() {
+    double nsPerTick = TscClock::nsPerTick();
+    uint64_t sink = 0;
+    double readNs = nsPer(NUM_SAMPLES, [&] {
+        for (int i = 0; i < NUM_SAMPLES; ++i) sink += TscClock::now();
+    });
+    LatencyHistogram timed;
+    double recordNs = nsPer(NUM_SAMPLES, [&] {
+        for (int i = 0; i < NUM_SAMPLES; ++i) timed.record(int64_t(i & 4095));
+    });
+
+    // Histogram percentiles against the exact ones, on a long-tailed sample.
+    mt19937_64 rng(25);
+    lognormal_distribution<double> shape(7.0, 1.0);
+    vector<int64_t> samples(NUM_SAMPLES);
+    LatencyHistogram histogram;
+    for (int64_t& v : samples) {
+        v = int64_t(shape(rng));
+        histogram.record(v);
+    }
+    sort(samples.begin(), samples.end());
+    LatencySummary approx = histogram.summary();
+    double worstError = 0.0;
+    for (auto [q, got] : {pair{0.50, approx.p50}, pair{0.99, approx.p99}, pair{0.999, approx.p999}}) {
+        int64_t exact = samples[size_t(ceil(q * NUM_SAMPLES)) - 1];
+        worstError = max(worstError, double(got - exact) / double(exact));
+    }
+
+    OrderBook ob(PoolConfig{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS)});
+    ob.setTickSize(0.01, 0.001);
+    atomic<bool> done{false};
+    uint64_t polls = 0;
+    thread reader([&] {
+        const LatencyRecorder& stats = ob.getLatencyStats();
+        while (!done.load(memory_order_acquire)) {
+            LatencySummary s = stats.summary(LatencyStage::TOTAL);
+            sink += uint64_t(s.p99);
+            polls++;
+        }
+    });
+
+    vector<int> placed;
+    placed.reserve(NUM_COMMANDS);
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 20) - 10) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        uint64_t kind = rng() % 16;
+        if (kind < 4 && !placed.empty()) ob.cancelOrder(placed[rng() % placed.size()]);
+        else if (kind == 4) ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, "Taker");
+        else if (kind == 5 && !placed.empty()) ob.modifyOrder(placed[rng() % placed.size()], price, qty);
+        else placed.push_back(ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, "Maker"));
+    }
+    done.store(true, memory_order_release);
+    reader.join();
+
+    oblog::flush();
+    cout << fixed << setprecision(3) << "TSC: " << 1.0 / nsPerTick << " ticks/ns | timestamp " << setprecision(1)
+         << readNs << " ns | histogram record " << recordNs << " ns\n"
+         << "Histogram vs exact percentiles (p50/p99/p99.9 of " << NUM_SAMPLES << " lognormal samples): worst error "
+         << setprecision(2) << worstError * 100 << "%\n"
+         << NUM_COMMANDS << " commands, " << polls << " summaries read concurrently\n";
+    ob.printLatencyStats();
+    if (sink == 42) printf(" ");
+    return 0;
+}
@@ -0,0 +1,69 @@
+// bench_logging.cpp
+// Per-order latency of the exchange engine with logging compiled in and
+// compiled out. Build twice:
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_DEBUG bench_logging.cpp -o bench_logging_on -pthread
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF   bench_logging.cpp -o bench_logging_off -pthread
+// Log output goes to /dev/null so only the cost on the calling thread is measured.
+
+#include "exchange_orderbook.h"
+
+#include <random>
+
+const int NUM_ORDERS = 200000;
+
+struct Request {
+    bool buy;
+    double price;
+    double qty;
+    bool cancel;
+};
+
+// Limit orders a few ticks either side of a fixed mid, so about half of them
+// cross; every fourth request cancels an earlier order instead.
+vector<Request> makeWorkload() {
+    mt19937_64 rng(7);
+    vector<Request> requests;
+    requests.reserve(NUM_ORDERS);
+    for (int i = 0; i < NUM_ORDERS; ++i) {
+        bool buy = rng() & 1;
+        double offset = double(int64_t(rng() % 40) - 20) * 0.01;
+        requests.push_back({buy, 67416.00 + offset, double(1 + rng() % 100) * 0.001, rng() % 4 == 0});
+    }
+    return requests;
+}
+
+int main() {
+#if OB_LOG_LEVEL < OB_LEVEL_OFF
+    oblog::Logger::instance().setOutput(fopen("/dev/null", "w"));
+#endif
+    vector<Request> requests = makeWorkload();
+    OrderBook ob(PoolConfig{.orderCapacity = size_t(NUM_ORDERS), .tradeCapacity = size_t(NUM_ORDERS) * 2});
+    ob.setTickSize(0.01, 0.001);
+
+    vector<int> placed;
+    vector<int64_t> latencies;
+    placed.reserve(NUM_ORDERS);
+    latencies.reserve(NUM_ORDERS);
+    mt19937_64 pick(11);
+
+    for (const Request& r : requests) {
+        auto start = chrono::steady_clock::now();
+        if (r.cancel && !placed.empty()) {
+            ob.cancelOrder(placed[pick() % placed.size()]);
+        } else {
+            placed.push_back(ob.placeOrder(r.buy ? "buy" : "sell", r.price, r.qty, LIMIT, "Bench"));
+        }
+        auto end = chrono::steady_clock::now();
+        latencies.push_back(chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+    }
+
+    sort(latencies.begin(), latencies.end());
+    auto pct = [&](double p) { return latencies[size_t(p * (latencies.size() - 1))]; };
+    double mean = accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+
+    oblog::flush();
+    cout << "Logging " << (OB_LOG_LEVEL < OB_LEVEL_OFF ? "on " : "off") << ": mean " << fixed << setprecision(0) << mean
+         << " ns | p50 " << pct(0.50) << " | p99 " << pct(0.99) << " | p99.9 " << pct(0.999)
+         << " | max " << latencies.back() << " ns | dropped records " << oblog::dropped() << endl;
+    return 0;
+}
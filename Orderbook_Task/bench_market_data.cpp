@@ -0,0 +1,125 @@
+// bench_market_data.cpp
+// Cost of the L2 feed on the matching thread, and whether a consumer on its
+// own thread ends up with the engine's depth. Runs the same flow with no feed,
+// a direct feed and a conflated feed; the consumer rebuilds the book from the
+// level updates and is compared with getDepth at the end.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_market_data.cpp -o bench_market_data -pthread
+
+#include "exchange_orderbook.h"
+
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <thread>
+
+const int NUM_COMMANDS = 200000;
+
+struct ConsumerBook {
+    map<Ticks, pair<Lots, uint32_t>> levels[2];
+    uint64_t updates = 0;
+
+    void apply(const LevelUpdate& u) {
+        updates++;
+        if (u.action == LevelAction::CLEAR) {
+            levels[0].clear();
+            levels[1].clear();
+        } else if (u.action == LevelAction::DELETE) {
+            levels[u.side].erase(u.price);
+        } else {
+            levels[u.side][u.price] = {u.quantity, u.orderCount};
+        }
+    }
+
+    bool matches(OrderBook& ob) const {
+        vector<DepthLevel> depth(10000);
+        for (int side = 0; side < 2; ++side) {
+            size_t n = ob.getDepth(side == 0 ? "buy" : "sell", depth.data(), depth.size());
+            if (n != levels[side].size()) return false;
+            for (size_t i = 0; i < n; ++i) {
+                auto it = levels[side].find(depth[i].price);
+                if (it == levels[side].end() || it->second != make_pair(depth[i].quantity, depth[i].orders)) return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Limit orders around a fixed mid with cancels and the odd market order, as in
+// bench_journal. Returns ns per command.
+double runFlow(OrderBook& ob) {
+    mt19937_64 rng(5);
+    vector<int> placed;
+    placed.reserve(NUM_COMMANDS);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 40) - 20) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        uint64_t kind = rng() % 16;
+        if (kind < 4 && !placed.empty()) ob.cancelOrder(placed[rng() % placed.size()]);
+        else if (kind == 5) ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, "Taker");
+        else placed.push_back(ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, buy ? "Bidder" : "Seller"));
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    return double(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / NUM_COMMANDS;
+}
+
+struct FeedResult {
+    double nsPerCommand;
+    MarketDataStats stats;
+    uint64_t received;
+    bool consistent;
+};
+
+FeedResult runWithFeed(const MarketDataConfig& config) {
+    OrderBook ob(PoolConfig{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS)});
+    ob.setTickSize(0.01, 0.001);
+    MarketDataPublisher publisher(config);
+    ob.attachMarketData(&publisher);
+
+    ConsumerBook view;
+    atomic<bool> done{false};
+    thread consumer([&] {
+        LevelUpdate update;
+        while (true) {
+            bool finished = done.load(memory_order_acquire);
+            bool any = false;
+            while (publisher.poll(update)) {
+                view.apply(update);
+                any = true;
+            }
+            if (finished && !any) break;
+            if (!any) this_thread::yield();
+        }
+    });
+
+    double ns = runFlow(ob);
+    while (publisher.pendingCount()) { // conflation mode: hand over what is left
+        publisher.flush();
+        this_thread::yield();
+    }
+    done.store(true, memory_order_release);
+    consumer.join();
+    return {ns, publisher.getStats(), view.updates, publisher.getStats().dropped == 0 && view.matches(ob)};
+}
+
+int main() {
+    OrderBook plain(PoolConfig{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS)});
+    plain.setTickSize(0.01, 0.001);
+    double baseline = runFlow(plain);
+
+    FeedResult direct = runWithFeed(MarketDataConfig{1 << 20, false});
+    FeedResult conflated = runWithFeed(MarketDataConfig{1 << 10, true});
+
+    oblog::flush();
+    cout << fixed << setprecision(1) << "L2 feed, " << NUM_COMMANDS << " commands (ns/command):\n"
+         << "  no feed    " << baseline << "\n";
+    for (auto [name, r] : {pair{"direct   ", direct}, pair{"conflated", conflated}}) {
+        cout << "  " << name << "  " << r.nsPerCommand << " | updates " << r.stats.produced << " produced, "
+             << r.received << " delivered, " << r.stats.conflated << " conflated, " << r.stats.dropped
+             << " dropped | consumer book " << (r.consistent ? "matches" : "DIFFERS") << "\n";
+    }
+    cout << flush;
+    return direct.consistent && conflated.consistent ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+// bench_order_archive.cpp
+// Long trading flow where nearly every order finishes (IOC, market, cancels,
+// fills) and only a thin book rests. Reports the live pool and ID index
+// against the number of orders ever placed, with finished orders retired to
+// the archive and its oldest chunks spilled to a file, then the cost of
+// looking an order up in each tier: live, archived in memory, and spilled.
+// Then times market orders that fill against one resting order, first while
+// that order shares their ID index page and then alone on a page of their
+// own, where each one leaves its page empty as it retires.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_order_archive.cpp -o bench_order_archive -pthread
+
+#include "exchange_orderbook.h"
+
+#include <cstdio>
+#include <random>
+
+const int NUM_COMMANDS = 2000000;
+const int LOOKUPS = 2000;
+
+int main() {
+    PoolConfig pools;
+    pools.orderCapacity = 1 << 14;
+    pools.archiveCapacity = 1 << 18;
+    pools.orderArchiveFile = "bench_order_archive.archive";
+    OrderBook ob(pools);
+    ob.setTickSize(0.01, 0.001);
+
+    mt19937_64 rng(23);
+    vector<int> placed;
+    int lastId = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 20) - 10) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        uint64_t kind = rng() % 16;
+        int id = -1;
+        if (kind < 4 && !placed.empty()) {
+            size_t k = rng() % placed.size();
+            ob.cancelOrder(placed[k]);
+            placed[k] = placed.back();
+            placed.pop_back();
+        } else if (kind < 6) {
+            id = ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, "Taker");
+        } else if (kind < 10) {
+            id = ob.placeOrder(buy ? "buy" : "sell", price, qty, IOC, "Taker");
+        } else {
+            id = ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, "Maker");
+            if (id > 0) placed.push_back(id);
+        }
+        lastId = max(lastId, id);
+    }
+    double nsPerCommand =
+        double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / NUM_COMMANDS;
+
+    // Probe IDs by tier: resting orders are live; finished ones are archived
+    // in memory from the newest IDs down, and spilled from the oldest half of
+    // what went to the file, since orders retire in roughly ID order.
+    vector<int> live, inMemory, spilled;
+    auto collect = [&](int id, Ticks, Lots) {
+        live.push_back(id);
+        return true;
+    };
+    ob.forEachRestingOrder("buy", collect);
+    ob.forEachRestingOrder("sell", collect);
+    for (size_t i = 0; !live.empty() && live.size() < LOOKUPS; ++i) live.push_back(live[i]);
+    const OrderArchiveStats& stats = ob.getArchiveStats();
+    for (int id = lastId; id > 0 && inMemory.size() < LOOKUPS; --id) {
+        ArchivedOrder rec;
+        if (ob.findOrderRecord(id, rec) && (rec.status == FILLED || rec.status == CANCELLED)) inMemory.push_back(id);
+    }
+    int spilledBelow = int(double(lastId) * double(stats.spilled) / double(max<uint64_t>(stats.archived, 1))) / 2;
+    for (int i = 0; i < LOOKUPS && spilledBelow > 0; ++i) spilled.push_back(int(1 + rng() % spilledBelow));
+
+    auto lookupNs = [&](const vector<int>& ids) {
+        ArchivedOrder rec;
+        uint64_t found = 0;
+        auto t0 = chrono::steady_clock::now();
+        for (int id : ids) found += ob.findOrderRecord(id, rec);
+        auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+        return ids.empty() || found != ids.size() ? -1.0 : double(ns) / double(ids.size());
+    };
+    double liveNs = lookupNs(live), memoryNs = lookupNs(inMemory), spilledNs = lookupNs(spilled);
+
+    // IDs 2..PAGE_SIZE - 1 share the resting sell's page; the next page's IDs
+    // are each the only live one on it.
+    OrderBook lone(PoolConfig{.orderCapacity = 1 << 10, .tradeCapacity = 1 << 18, .archiveCapacity = 1 << 10});
+    lone.setTickSize(0.01, 0.001);
+    lone.placeOrder("sell", 67416.00, 1000.0, LIMIT, "Maker");
+    auto marketNs = [&](int orders) {
+        auto t0 = chrono::steady_clock::now();
+        for (int i = 0; i < orders; ++i) lone.placeOrder("buy", 0.0, 0.001, MARKET, "Taker");
+        auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+        return double(ns) / double(orders);
+    };
+    double sharedPageNs = marketNs(int(OrderIndex::PAGE_SIZE) - 2);
+    double ownPageNs = marketNs(int(OrderIndex::PAGE_SIZE));
+
+    const PoolStats& pool = ob.getOrderPoolStats();
+    oblog::flush();
+    cout << fixed << setprecision(1) << "Order archive, " << NUM_COMMANDS << " commands (" << nsPerCommand
+         << " ns/command)\n"
+         << "  orders placed   " << lastId << "\n"
+         << "  live orders     " << ob.liveOrderCount() << " | pool in use " << pool.inUse << ", high water "
+         << pool.highWater << ", grows " << pool.grows << "\n"
+         << "  ID index        " << double(ob.orderIndexBytes()) / 1e6 << " MB\n"
+         << "  archived        " << stats.archived << " | in memory " << stats.inMemory << ", spilled "
+         << stats.spilled << ", spill failures " << stats.spillFailures << "\n"
+         << "  lookup (ns)     live " << liveNs << " | archived in memory " << memoryNs << " | spilled "
+         << spilledNs << "\n"
+         << "  market order    " << sharedPageNs << " ns sharing an index page | " << ownPageNs
+         << " ns alone on one" << endl;
+    remove(pools.orderArchiveFile.c_str());
+    return 0;
+}
@@ -0,0 +1,98 @@
+// bench_order_index.cpp
+// Memory footprint and lookup cost of the order-ID index against the
+// unordered_map<int, Order*> it replaced, for sequential IDs as the engine
+// issues them. Heap bytes are counted through operator new; lookups are
+// random IDs, done one by one and in prefetched batches of 16. The map is
+// skipped past 10M IDs (it would need several GB); the index goes to 100M.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_order_index.cpp -o bench_order_index -pthread
+
+#include "order_index.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+static atomic<uint64_t> heapBytes{0};
+
+void* operator new(size_t size) {
+    heapBytes.fetch_add(size, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // new above is malloc
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+#pragma GCC diagnostic pop
+
+const size_t LOOKUPS = 4000000;
+
+template <typename F>
+double nsPer(size_t n, F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / double(n);
+}
+
+int main() {
+    printf("Order-ID index, sequential IDs, %zu random lookups\n", LOOKUPS);
+    printf("%12s  %-14s %10s %8s %12s %12s %12s\n", "IDs", "structure", "MB", "B/ID", "insert ns", "lookup ns",
+           "batched ns");
+    for (size_t n : {size_t(1000000), size_t(10000000), size_t(100000000)}) {
+        mt19937_64 rng(n);
+        vector<int> probes(LOOKUPS);
+        for (int& id : probes) id = int(1 + rng() % n);
+        uint64_t sink = 0;
+
+        auto report = [&](const char* name, uint64_t bytes, double insertNs, double lookupNs, double batchedNs) {
+            printf("%12zu  %-14s %10.1f %8.1f %12.1f %12.1f", n, name, double(bytes) / 1e6, double(bytes) / double(n),
+                   insertNs, lookupNs);
+            if (batchedNs > 0) printf(" %12.1f\n", batchedNs);
+            else printf(" %12s\n", "-");
+        };
+
+        {
+            uint64_t before = heapBytes.load();
+            auto index = make_unique<OrderIndex>();
+            double insertNs = nsPer(n, [&] {
+                for (size_t id = 1; id <= n; ++id) index->insert(int(id), uint32_t(id));
+            });
+            uint64_t bytes = heapBytes.load() - before;
+            double lookupNs = nsPer(LOOKUPS, [&] {
+                for (int id : probes) sink += index->find(id);
+            });
+            double batchedNs = nsPer(LOOKUPS, [&] {
+                for (size_t i = 0; i < probes.size(); ++i) {
+                    if (i + 16 < probes.size()) index->prefetch(probes[i + 16]);
+                    sink += index->find(probes[i]);
+                }
+            });
+            report("OrderIndex", bytes, insertNs, lookupNs, batchedNs);
+        }
+
+        if (n <= 10000000) {
+            uint64_t before = heapBytes.load();
+            auto map = make_unique<unordered_map<int, void*>>();
+            double insertNs = nsPer(n, [&] {
+                for (size_t id = 1; id <= n; ++id) (*map)[int(id)] = reinterpret_cast<void*>(id);
+            });
+            uint64_t bytes = heapBytes.load() - before;
+            double lookupNs = nsPer(LOOKUPS, [&] {
+                for (int id : probes) sink += uintptr_t(map->find(id)->second);
+            });
+            report("unordered_map", bytes, insertNs, lookupNs, 0.0); // nothing to prefetch without hashing first
+        }
+        if (sink == 42) printf(" ");
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+// bench_order_layout.cpp
+// Builds deep levels of small resting orders, then sweeps them with market
+// orders and reports the cost per order consumed, next to the size of the hot
+// Order record and its cold entry. Each fill reads and writes one hot record;
+// the cold table is not touched until the order is reported or snapshotted.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_order_layout.cpp -o bench_order_layout -pthread
+
+#include "exchange_orderbook.h"
+
+#include <cstdio>
+#include <random>
+
+const int LEVELS = 20;
+const int ORDERS_PER_LEVEL = 10000;
+const int ROUNDS = 5;
+
+int main() {
+    const int resting = LEVELS * ORDERS_PER_LEVEL;
+    PoolConfig pools{.orderCapacity = size_t(resting) * 2, .tradeCapacity = size_t(resting) * 2};
+    double sweepNs = 0.0, buildNs = 0.0;
+    uint64_t filled = 0;
+    for (int round = 0; round < ROUNDS; ++round) {
+        OrderBook ob(pools);
+        ob.setTickSize(0.01, 0.001);
+        mt19937_64 rng(round);
+
+        // Interleave the levels so consecutive orders of one level are not
+        // neighbours in the pool, as in a live book.
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < ORDERS_PER_LEVEL; ++i) {
+            for (int level = 0; level < LEVELS; ++level) {
+                ob.placeOrder("sell", 67416.00 + level * 0.01, double(1 + rng() % 5) * 0.001, LIMIT,
+                              "Maker" + to_string(rng() % 64));
+            }
+        }
+        buildNs += double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+        start = chrono::steady_clock::now();
+        while (ob.getBestAsk()) ob.placeOrder("buy", 0.0, 100.0, MARKET, "Taker");
+        sweepNs += double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        filled += ob.getTradeStoreStats().recorded;
+    }
+
+    oblog::flush();
+    cout << fixed << setprecision(1) << "Order layout: Order " << sizeof(Order) << " bytes (align " << alignof(Order)
+         << "), OrderCold " << sizeof(OrderCold) << " bytes\n"
+         << "  " << LEVELS << " levels x " << ORDERS_PER_LEVEL << " orders, " << ROUNDS << " rounds\n"
+         << "  rest   " << buildNs / (double(resting) * ROUNDS) << " ns/order\n"
+         << "  sweep  " << sweepNs / double(filled) << " ns/order consumed (" << filled << " fills)" << endl;
+    return 0;
+}
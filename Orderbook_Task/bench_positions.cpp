@@ -0,0 +1,78 @@
+// bench_positions.cpp
+// Runs the same trading flow with few and with many distinct client IDs and
+// reports the matching cost per command and per fill. Fills hash nothing;
+// what the large client set adds is interning each new ID at order entry and
+// cache misses across a larger position array. Then checks the PnL
+// bookkeeping: every order has a client, so across all clients positions net
+// to zero, realized + unrealized PnL sums to zero and the fees attributed to
+// clients add up to the fees on the trades.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_positions.cpp -o bench_positions -pthread
+
+#include "exchange_orderbook.h"
+
+#include <cstdio>
+#include <random>
+
+const int NUM_COMMANDS = 200000;
+
+struct Result {
+    double nsPerCommand;
+    double nsPerFill;
+    uint64_t fills;
+    double netQty;
+    double netPnl;
+    double feeGap;
+};
+
+Result runFlow(int clients) {
+    OrderBook ob(PoolConfig{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS)});
+    ob.setTickSize(0.01, 0.001);
+    vector<string> names(clients);
+    for (int c = 0; c < clients; ++c) names[c] = "Client" + to_string(c);
+
+    mt19937_64 rng(17);
+    vector<int> placed;
+    placed.reserve(NUM_COMMANDS);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 20) - 10) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        const string& client = names[rng() % clients];
+        uint64_t kind = rng() % 16;
+        if (kind < 3 && !placed.empty()) ob.cancelOrder(placed[rng() % placed.size()]);
+        else if (kind == 3) ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, client);
+        else placed.push_back(ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, client));
+    }
+    auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    Result r{};
+    r.fills = ob.getTradeStoreStats().recorded;
+    r.nsPerCommand = double(elapsed) / NUM_COMMANDS;
+    r.nsPerFill = double(elapsed) / double(max<uint64_t>(r.fills, 1));
+    double fees = 0.0;
+    ob.forEachTrade([&](const Trade& t) { fees += t.fee; });
+    for (const string& name : names) {
+        if (optional<PositionReport> pos = ob.getPosition(name)) {
+            r.netQty += pos->quantity;
+            r.netPnl += pos->realizedPnl + pos->unrealizedPnl;
+            fees -= pos->feesPaid;
+        }
+    }
+    r.feeGap = fees;
+    return r;
+}
+
+int main() {
+    oblog::flush();
+    cout << "Positions, " << NUM_COMMANDS << " commands\n";
+    for (int clients : {16, 100000}) {
+        Result r = runFlow(clients);
+        oblog::flush();
+        cout << fixed << setprecision(1) << "  " << setw(6) << clients << " clients  " << r.nsPerCommand
+             << " ns/command, " << r.nsPerFill << " ns/fill (" << r.fills << " fills) | net qty "
+             << setprecision(6) << r.netQty << ", net PnL " << r.netPnl << ", unattributed fees " << r.feeGap
+             << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// bench_price_ladder.cpp
+// Compares the two price-level backends (std::map vs direct-indexed ladder)
+// on the same replayed workload: inserts around a drifting mid, fills at the
+// touch and cancels of resting levels.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "book_side.h"
+
+struct Level {
+    int64_t qty = 0;
+    int orders = 0;
+    void clear() { qty = 0; orders = 0; }
+};
+
+enum OpKind { INSERT, FILL, CANCEL };
+
+struct Op {
+    OpKind kind;
+    bool bid;
+    int64_t price;
+    int64_t qty;
+};
+
+const int NUM_OPS = 2000000;
+
+// Prices random-walk around a mid so the ladder has to recenter now and then.
+std::vector<Op> makeWorkload() {
+    std::mt19937_64 rng(42);
+    std::vector<Op> ops;
+    ops.reserve(NUM_OPS);
+    int64_t mid = 6741600;
+    for (int i = 0; i < NUM_OPS; ++i) {
+        if (rng() % 64 == 0) mid += int64_t(rng() % 5) - 2;
+        bool bid = rng() & 1;
+        int64_t offset = 1 + int64_t(rng() % 100);
+        int roll = int(rng() % 100);
+        OpKind kind = roll < 45 ? INSERT : roll < 60 ? FILL : CANCEL;
+        ops.push_back({kind, bid, bid ? mid - offset : mid + offset, 1 + int64_t(rng() % 100)});
+    }
+    return ops;
+}
+
+template <typename Side>
+void apply(Side& side, const Op& op, int64_t& checksum) {
+    if (op.kind == INSERT) {
+        Level& level = side[op.price];
+        level.qty += op.qty;
+        level.orders++;
+    } else if (op.kind == FILL) {
+        if (side.empty()) return;
+        int64_t price = side.bestPrice();
+        Level& level = side.best();
+        checksum += price;
+        if (--level.orders == 0) side.erase(price);
+    } else {
+        Level* level = side.find(op.price);
+        if (!level) return;
+        if (--level->orders == 0) side.erase(op.price);
+    }
+}
+
+template <typename Backend>
+void run(const char* name, const std::vector<Op>& ops) {
+    typename Backend::template Side<Level, true> bids;
+    typename Backend::template Side<Level, false> asks;
+    int64_t checksum = 0;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const Op& op : ops) {
+        if (op.bid) apply(bids, op, checksum);
+        else apply(asks, op, checksum);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    std::cout << name << " backend: " << double(ns) / ops.size() << " ns/op"
+              << " (levels: " << bids.size() + asks.size() << ", checksum: " << checksum << ")\n";
+}
+
+int main() {
+    std::vector<Op> ops = makeWorkload();
+    run<MapBackend>("Map   ", ops);
+    run<LadderBackend>("Ladder", ops);
+    return 0;
+}
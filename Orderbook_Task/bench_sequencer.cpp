@@ -0,0 +1,78 @@
+// bench_sequencer.cpp
+// Several gateway threads feed one book through the sequencer. Each gateway
+// submits requests and collects the responses; reports round-trip latency
+// and checks every request got exactly one response with a unique sequence.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_sequencer.cpp -o bench_sequencer -pthread
+
+#include "sequencer.h"
+
+#include <random>
+
+const int NUM_GATEWAYS = 4;
+const int REQUESTS_PER_GATEWAY = 50000;
+const int WINDOW = 256; // requests in flight per gateway
+
+int main() {
+    OrderBook ob(PoolConfig{.orderCapacity = size_t(NUM_GATEWAYS * REQUESTS_PER_GATEWAY),
+                            .tradeCapacity = size_t(NUM_GATEWAYS * REQUESTS_PER_GATEWAY)});
+    ob.setTickSize(0.01, 0.001);
+    Sequencer<> sequencer(ob);
+    vector<Sequencer<>::GatewayHandle> handles;
+    for (int g = 0; g < NUM_GATEWAYS; ++g) handles.push_back(sequencer.addGateway());
+    sequencer.start();
+
+    vector<vector<int64_t>> latencies(NUM_GATEWAYS);
+    vector<vector<uint64_t>> seqs(NUM_GATEWAYS);
+    auto start = chrono::steady_clock::now();
+    vector<thread> gateways;
+    for (int g = 0; g < NUM_GATEWAYS; ++g) {
+        gateways.emplace_back([&, g] {
+            mt19937_64 rng(g + 1);
+            vector<chrono::steady_clock::time_point> sentAt(REQUESTS_PER_GATEWAY);
+            latencies[g].reserve(REQUESTS_PER_GATEWAY);
+            seqs[g].reserve(REQUESTS_PER_GATEWAY);
+            int sent = 0, received = 0;
+            GatewayResponse response;
+            while (received < REQUESTS_PER_GATEWAY) {
+                while (sent < REQUESTS_PER_GATEWAY && sent - received < WINDOW) {
+                    bool buy = rng() & 1;
+                    double price = 67416.00 + double(int64_t(rng() % 40) - 20) * 0.01;
+                    SymbolCommand c = SymbolCommand::place(0, buy, price, double(1 + rng() % 100) * 0.001, LIMIT,
+                                                           "Gateway" + to_string(g));
+                    sentAt[sent] = chrono::steady_clock::now();
+                    if (!handles[g].submit(uint64_t(sent), c)) break;
+                    ++sent;
+                }
+                while (handles[g].poll(response)) {
+                    latencies[g].push_back(chrono::duration_cast<chrono::nanoseconds>(
+                        chrono::steady_clock::now() - sentAt[response.tag]).count());
+                    seqs[g].push_back(response.seq);
+                    ++received;
+                }
+                this_thread::yield();
+            }
+        });
+    }
+    for (auto& t : gateways) t.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    sequencer.stop();
+
+    vector<int64_t> all;
+    vector<uint64_t> allSeqs;
+    for (int g = 0; g < NUM_GATEWAYS; ++g) {
+        all.insert(all.end(), latencies[g].begin(), latencies[g].end());
+        allSeqs.insert(allSeqs.end(), seqs[g].begin(), seqs[g].end());
+    }
+    sort(all.begin(), all.end());
+    sort(allSeqs.begin(), allSeqs.end());
+    bool unique = adjacent_find(allSeqs.begin(), allSeqs.end()) == allSeqs.end() &&
+                  allSeqs.size() == size_t(NUM_GATEWAYS * REQUESTS_PER_GATEWAY);
+    auto pct = [&](double p) { return all[size_t(p * (all.size() - 1))]; };
+
+    oblog::flush();
+    cout << NUM_GATEWAYS << " gateways, " << all.size() << " requests in " << fixed << setprecision(1)
+         << seconds * 1e3 << " ms (" << setprecision(0) << all.size() / seconds << " req/s) | round trip p50 "
+         << pct(0.50) << " ns | p99 " << pct(0.99) << " ns | sequence numbers "
+         << (unique ? "unique" : "DUPLICATED") << endl;
+    return unique ? 0 : 1;
+}
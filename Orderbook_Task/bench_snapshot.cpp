@@ -0,0 +1,84 @@
+// bench_snapshot.cpp
+// How long a snapshot holds up the matching thread: saveSnapshot (capture +
+// file write + fdatasync) against saveSnapshotAsync (queues a request; the
+// SnapshotWriter's mirror captures and writes), on a book of NUM_ORDERS resting
+// orders. Fails if an async request stalls matching past MAX_ASYNC_STALL_US or
+// its snapshot does not load back into the same book as the synchronous one.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_snapshot.cpp -o bench_snapshot -pthread
+
+#include "exchange_orderbook.h"
+
+#include <cstdio>
+#include <random>
+
+const int NUM_ORDERS = 200000;
+const int ROUNDS = 10;
+const double MAX_ASYNC_STALL_US = 100;
+const char* SNAPSHOT_PATH = "bench.snapshot";
+const char* ASYNC_PATH = "bench_async.snapshot";
+
+double millis(chrono::steady_clock::duration d) { return chrono::duration<double, milli>(d).count(); }
+
+bool sameBook(OrderBook& a, OrderBook& b) {
+    vector<DepthLevel> da(4096), db(4096);
+    for (const char* side : {"buy", "sell"}) {
+        size_t na = a.getDepth(side, da.data(), da.size());
+        size_t nb = b.getDepth(side, db.data(), db.size());
+        if (na != nb) return false;
+        for (size_t i = 0; i < na; ++i) {
+            if (da[i].price != db[i].price || da[i].quantity != db[i].quantity || da[i].orders != db[i].orders)
+                return false;
+        }
+    }
+    return a.getOrderPoolStats().inUse == b.getOrderPoolStats().inUse;
+}
+
+int main() {
+    PoolConfig pools{.orderCapacity = size_t(NUM_ORDERS), .tradeCapacity = size_t(NUM_ORDERS)};
+    OrderBook ob(pools);
+    SnapshotWriter<OrderBook::Mirror> writer(pools);
+    ob.setTickSize(0.01, 0.001);
+    ob.attachSnapshotWriter(&writer);
+    mt19937_64 rng(3);
+    for (int i = 0; i < NUM_ORDERS; ++i) {
+        bool buy = i & 1;
+        double offset = double(1 + rng() % 2000) * 0.01;
+        ob.placeOrder(buy ? "buy" : "sell", 67416.00 + (buy ? -offset : offset), double(1 + rng() % 100) * 0.001,
+                      LIMIT, "Client" + to_string(i % 64));
+    }
+
+    double syncWorst = 0, asyncWorst = 0, syncTotal = 0, asyncTotal = 0;
+    bool matches = true;
+    for (int round = 0; round < ROUNDS; ++round) {
+        auto start = chrono::steady_clock::now();
+        ob.saveSnapshot(SNAPSHOT_PATH);
+        double stall = millis(chrono::steady_clock::now() - start);
+        syncWorst = max(syncWorst, stall);
+        syncTotal += stall;
+
+        start = chrono::steady_clock::now();
+        ob.saveSnapshotAsync(ASYNC_PATH);
+        stall = millis(chrono::steady_clock::now() - start);
+        asyncWorst = max(asyncWorst, stall);
+        asyncTotal += stall;
+        // Trade between snapshots, so the mirror has commands to catch up on.
+        for (int i = 0; i < 1000; ++i) ob.placeOrder(i & 1 ? "buy" : "sell", 0.0, 0.001, MARKET, "Taker");
+        matches = writer.wait().ok && matches;
+
+        OrderBook fromSync(pools), fromAsync(pools);
+        matches = fromSync.loadSnapshot(SNAPSHOT_PATH) && fromAsync.loadSnapshot(ASYNC_PATH) &&
+                  sameBook(fromSync, fromAsync) && matches;
+    }
+
+    bool fast = asyncWorst * 1e3 <= MAX_ASYNC_STALL_US;
+    oblog::flush();
+    cout << fixed << setprecision(3) << "Snapshot of " << NUM_ORDERS << " orders, matching thread blocked for:\n"
+         << "  saveSnapshot      mean " << syncTotal / ROUNDS << " ms | max " << syncWorst << " ms\n"
+         << "  saveSnapshotAsync mean " << asyncTotal / ROUNDS * 1e3 << " us | max " << asyncWorst * 1e3 << " us ("
+         << (fast ? "within " : "OVER ") << MAX_ASYNC_STALL_US << " us) | " << writer.getStats().queueWaits
+         << " mirror queue waits | images " << (matches ? "match" : "DIFFER") << endl;
+    ob.attachSnapshotWriter(nullptr);
+    remove(SNAPSHOT_PATH);
+    remove(ASYNC_PATH);
+    return fast && matches ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+// bench_symbols.cpp
+// Throughput of the multi-symbol engine: NUM_SYMBOLS books sharded across
+// worker threads, fed from one routing thread. Afterwards every book is
+// compared against the same commands applied on a single thread.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_symbols.cpp -o bench_symbols -pthread
+
+#include "symbol_engine.h"
+
+#include <random>
+
+const int NUM_SYMBOLS = 256;
+const int NUM_COMMANDS = 400000;
+
+vector<SymbolCommand> makeWorkload() {
+    mt19937_64 rng(5);
+    vector<SymbolCommand> commands;
+    commands.reserve(NUM_COMMANDS);
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        SymbolId symbol = SymbolId(rng() % NUM_SYMBOLS);
+        bool buy = rng() & 1;
+        double price = 100.00 + double(int64_t(rng() % 40) - 20) * 0.01;
+        if (rng() % 4 == 0) commands.push_back(SymbolCommand::cancel(symbol, int(1 + rng() % 1000)));
+        else commands.push_back(SymbolCommand::place(symbol, buy, price, double(1 + rng() % 100) * 0.001, LIMIT, "Bench"));
+    }
+    return commands;
+}
+
+bool sameBook(OrderBook& a, OrderBook& b) {
+    DepthLevel da[64], db[64];
+    for (const char* side : {"buy", "sell"}) {
+        size_t na = a.getDepth(side, da, 64), nb = b.getDepth(side, db, 64);
+        if (na != nb) return false;
+        for (size_t i = 0; i < na; ++i) {
+            if (da[i].price != db[i].price || da[i].quantity != db[i].quantity) return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    vector<SymbolCommand> commands = makeWorkload();
+    size_t workers = max(1u, min(4u, thread::hardware_concurrency()));
+    EngineConfig config;
+    config.workers = workers;
+    for (size_t i = 0; i < workers; ++i) config.cores.push_back(int(i));
+
+    SymbolEngine<> engine(config);
+    PoolConfig pools{.orderCapacity = 4096, .tradeCapacity = 4096};
+    for (int i = 0; i < NUM_SYMBOLS; ++i) engine.addSymbol({"SYM" + to_string(i), 0.01, 0.001, 0.001, 0.002, pools});
+    engine.start();
+
+    auto start = chrono::steady_clock::now();
+    for (const SymbolCommand& c : commands) {
+        while (!engine.submit(c)) this_thread::yield();
+    }
+    engine.drain();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    engine.stop();
+
+    vector<unique_ptr<OrderBook>> reference;
+    for (int i = 0; i < NUM_SYMBOLS; ++i) {
+        reference.push_back(make_unique<OrderBook>(pools));
+        reference.back()->setTickSize(0.01, 0.001);
+    }
+    for (const SymbolCommand& c : commands) {
+        OrderBook& book = *reference[c.symbol];
+        if (c.command == CommandType::CANCEL) book.cancelOrder(c.orderId);
+        else book.placeOrder(c.side == 0 ? "buy" : "sell", c.price, c.quantity, LIMIT, c.clientId);
+    }
+    int matching = 0;
+    for (int i = 0; i < NUM_SYMBOLS; ++i) matching += sameBook(engine.book(SymbolId(i)), *reference[i]);
+
+    oblog::flush();
+    cout << NUM_SYMBOLS << " symbols on " << workers << " workers: " << NUM_COMMANDS << " commands in " << fixed
+         << setprecision(1) << seconds * 1e3 << " ms (" << setprecision(0) << NUM_COMMANDS / seconds
+         << " commands/s) | books matching single-thread run: " << matching << "/" << NUM_SYMBOLS << endl;
+    return matching == NUM_SYMBOLS ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// bench_top_of_book.cpp
+// The matching thread runs a flow of commands while reader threads poll the
+// seqlock-published top of book. Reports the matching cost with and without
+// readers, each reader's rate, how often a single tryReadTopOfBook attempt
+// hit a write in progress, and checks every copy read was consistent (book
+// uncrossed, sequence never going backwards). Readers yield between reads,
+// like a risk thread checking once per incoming order; give them their own
+// cores or they only compete with the matching thread for CPU time.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_top_of_book.cpp -o bench_top_of_book -pthread
+
+#include "exchange_orderbook.h"
+
+#include <atomic>
+#include <cstdio>
+#include <random>
+#include <thread>
+
+const int NUM_COMMANDS = 200000;
+const int NUM_READERS = 3;
+
+struct ReaderResult {
+    uint64_t reads = 0;
+    uint64_t busy = 0; // tryReadTopOfBook attempts that found a write in progress
+    uint64_t inconsistent = 0;
+};
+
+double runFlow(OrderBook& ob) {
+    mt19937_64 rng(5);
+    vector<int> placed;
+    placed.reserve(NUM_COMMANDS);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 40) - 20) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        uint64_t kind = rng() % 16;
+        if (kind < 4 && !placed.empty()) ob.cancelOrder(placed[rng() % placed.size()]);
+        else if (kind == 5) ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, "Taker");
+        else placed.push_back(ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, buy ? "Bidder" : "Seller"));
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    return double(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / NUM_COMMANDS;
+}
+
+int main() {
+    PoolConfig pools{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS)};
+    OrderBook quiet(pools);
+    quiet.setTickSize(0.01, 0.001);
+    double alone = runFlow(quiet);
+
+    OrderBook ob(pools);
+    ob.setTickSize(0.01, 0.001);
+    atomic<bool> done{false};
+    vector<ReaderResult> results(NUM_READERS);
+    vector<thread> readers;
+    for (int r = 0; r < NUM_READERS; ++r) {
+        readers.emplace_back([&, r] {
+            ReaderResult& result = results[r];
+            uint64_t lastSequence = 0;
+            TopOfBook touch;
+            while (!done.load(memory_order_relaxed)) {
+                if (!ob.tryReadTopOfBook(touch)) {
+                    result.busy++;
+                    touch = ob.readTopOfBook();
+                }
+                result.reads++;
+                bool crossed = touch.bidOrders && touch.askOrders && touch.bidPrice >= touch.askPrice;
+                if (crossed || touch.sequence < lastSequence) result.inconsistent++;
+                lastSequence = touch.sequence;
+                this_thread::yield();
+            }
+        });
+    }
+    double contended = runFlow(ob);
+    done.store(true);
+    for (thread& t : readers) t.join();
+
+    TopOfBook last = ob.readTopOfBook();
+    oblog::flush();
+    cout << fixed << setprecision(1) << "Top of book, " << NUM_COMMANDS << " commands, " << last.sequence
+         << " touch changes published\n"
+         << "  hardware threads      " << thread::hardware_concurrency() << "\n"
+         << "  matching alone        " << alone << " ns/command\n"
+         << "  with " << NUM_READERS << " readers        " << contended << " ns/command\n";
+    uint64_t inconsistent = 0;
+    for (int r = 0; r < NUM_READERS; ++r) {
+        const ReaderResult& result = results[r];
+        inconsistent += result.inconsistent;
+        cout << "  reader " << r << "  " << result.reads << " reads, " << setprecision(3)
+             << 100.0 * double(result.busy) / double(max<uint64_t>(result.reads, 1)) << "% first attempts busy, "
+             << result.inconsistent << " inconsistent\n" << setprecision(1);
+    }
+    cout << setprecision(2) << "  final touch  " << ob.toPrice(last.bidPrice) << " x " << setprecision(3)
+         << ob.toQty(last.bidQty) << " | " << setprecision(2) << ob.toPrice(last.askPrice) << " x " << setprecision(3)
+         << ob.toQty(last.askQty) << endl;
+    return inconsistent == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+// bench_trade_store.cpp
+// Runs a flow that trades heavily with trade memory capped and a spill
+// directory, then queries the history. Reports the matching cost against an
+// uncapped book, the trades held in memory versus spilled, and the cost of a
+// time-range query and an order-ID query against filtering a full scan.
+//   g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_trade_store.cpp -o bench_trade_store -pthread
+
+#include "exchange_orderbook.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+const int NUM_COMMANDS = 400000;
+const size_t TRADE_MEMORY = 1 << 14;
+const char* SPILL_DIR = "trade_spill";
+
+double runFlow(OrderBook& ob, vector<int>& placed) {
+    mt19937_64 rng(11);
+    placed.reserve(NUM_COMMANDS);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < NUM_COMMANDS; ++i) {
+        bool buy = rng() & 1;
+        double price = 67416.00 + double(int64_t(rng() % 10) - 5) * 0.01;
+        double qty = double(1 + rng() % 100) * 0.001;
+        if (rng() % 8 == 0) ob.placeOrder(buy ? "buy" : "sell", 0.0, qty, MARKET, "Taker");
+        else placed.push_back(ob.placeOrder(buy ? "buy" : "sell", price, qty, LIMIT, buy ? "Bidder" : "Seller"));
+    }
+    auto elapsed = chrono::steady_clock::now() - start;
+    return double(chrono::duration_cast<chrono::nanoseconds>(elapsed).count()) / NUM_COMMANDS;
+}
+
+template <typename F>
+double timeUs(F&& f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    return double(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()) / 1000.0;
+}
+
+int main() {
+    filesystem::remove_all(SPILL_DIR);
+    filesystem::create_directories(SPILL_DIR);
+
+    vector<int> placed;
+    OrderBook uncapped(PoolConfig{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = size_t(NUM_COMMANDS)});
+    uncapped.setTickSize(0.01, 0.001);
+    double uncappedNs = runFlow(uncapped, placed);
+
+    placed.clear();
+    PoolConfig pools{.orderCapacity = size_t(NUM_COMMANDS), .tradeCapacity = TRADE_MEMORY};
+    pools.tradeSpillDir = SPILL_DIR;
+    OrderBook ob(pools);
+    ob.setTickSize(0.01, 0.001);
+    double cappedNs = runFlow(ob, placed);
+
+    // Queries over the most recent 1% of the day and for an order from early on.
+    vector<chrono::system_clock::time_point> times;
+    ob.forEachTrade([&](const Trade& t) { times.push_back(t.timestamp); });
+    auto from = times[times.size() - times.size() / 100];
+    auto to = times.back() + chrono::nanoseconds(1);
+    int orderId = placed[placed.size() / 10];
+
+    size_t scanned = 0, inRange = 0, ofOrder = 0;
+    double scanRangeUs = timeUs([&] {
+        ob.forEachTrade([&](const Trade& t) {
+            scanned++;
+            if (t.timestamp >= from && t.timestamp < to) inRange++;
+        });
+    });
+    size_t queriedRange = 0;
+    double rangeUs = timeUs([&] { ob.forEachTrade(from, to, [&](const Trade&) { queriedRange++; }); });
+
+    double scanOrderUs = timeUs([&] {
+        ob.forEachTrade([&](const Trade& t) {
+            if (t.buyOrderId == orderId || t.sellOrderId == orderId) ofOrder++;
+        });
+    });
+    size_t queriedOrder = 0;
+    double orderUs = timeUs([&] { ob.forEachTradeOfOrder(orderId, [&](const Trade&) { queriedOrder++; }); });
+
+    const PoolStats& pool = ob.getTradePoolStats();
+    const TradeStoreStats& store = ob.getTradeStoreStats();
+    oblog::flush();
+    cout << fixed << setprecision(1) << "Trade store, " << NUM_COMMANDS << " commands, " << store.recorded
+         << " trades\n"
+         << "  matching, trades all in memory   " << uncappedNs << " ns/command\n"
+         << "  matching, " << TRADE_MEMORY << " in memory + spill  " << cappedNs << " ns/command\n"
+         << "  in memory " << pool.inUse << " (high water " << pool.highWater << ", capacity " << pool.capacity
+         << "), spilled " << store.spilled << " (" << store.spillFailures << " failures, " << store.spillWaits
+         << " waits for the writer), " << scanned << " queryable\n"
+         << "  last 1% by time     full scan " << scanRangeUs << " us, query " << rangeUs << " us, "
+         << queriedRange << (queriedRange == inRange ? " trades (match)" : " trades (MISMATCH)") << "\n"
+         << "  order " << orderId << "       full scan " << scanOrderUs << " us, query " << orderUs << " us, "
+         << queriedOrder << (queriedOrder == ofOrder ? " trades (match)" : " trades (MISMATCH)") << endl;
+    return queriedRange == inRange && queriedOrder == ofOrder && scanned == store.recorded ? 0 : 1;
+}
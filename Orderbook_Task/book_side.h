@@ -0,0 +1,110 @@
+#ifndef BOOK_SIDE_H
+#define BOOK_SIDE_H
+
+// Interchangeable storage for one side of the book. Both backends expose the
+// same small interface so OrderBook can be built on either:
+//   empty(), size(), bestPrice(), best(), find(price), operator[](price),
+//   erase(price), clear(), forEach(f) with f(price, level) -> keep going?
+// plus depth bookkeeping for liquidity queries:
+//   addDepth(price, delta), depthAt(price), totalDepth(), depthUpTo(price),
+//   sweep(qty) -> SweepResult
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <type_traits>
+
+#include "price_ladder.h"
+
+// Red-black tree keyed by price; the original book layout. Depth queries walk
+// the levels.
+template <typename Level, bool IsBid>
+class MapBookSide {
+private:
+    using Better = std::conditional_t<IsBid, std::greater<int64_t>, std::less<int64_t>>;
+
+    struct Entry {
+        Level level;
+        int64_t depth = 0;
+    };
+
+    std::map<int64_t, Entry, Better> levels;
+    int64_t totalQty = 0;
+
+public:
+    bool empty() const { return levels.empty(); }
+    size_t size() const { return levels.size(); }
+    int64_t bestPrice() const { return levels.begin()->first; }
+    Level& best() { return levels.begin()->second.level; }
+
+    Level* find(int64_t price) {
+        auto it = levels.find(price);
+        return it == levels.end() ? nullptr : &it->second.level;
+    }
+
+    Level& operator[](int64_t price) { return levels[price].level; }
+
+    void erase(int64_t price) {
+        auto it = levels.find(price);
+        if (it == levels.end()) return;
+        totalQty -= it->second.depth;
+        levels.erase(it);
+    }
+
+    void clear() {
+        levels.clear();
+        totalQty = 0;
+    }
+
+    template <typename F>
+    void forEach(F&& f) {
+        for (auto& [price, entry] : levels) {
+            if (!f(price, entry.level)) return;
+        }
+    }
+
+    void addDepth(int64_t price, int64_t delta) {
+        levels[price].depth += delta;
+        totalQty += delta;
+    }
+
+    int64_t depthAt(int64_t price) const {
+        auto it = levels.find(price);
+        return it == levels.end() ? 0 : it->second.depth;
+    }
+
+    int64_t totalDepth() const { return totalQty; }
+
+    int64_t depthUpTo(int64_t price) const {
+        int64_t sum = 0;
+        for (auto it = levels.begin(); it != levels.end() && !Better{}(price, it->first); ++it) {
+            sum += it->second.depth;
+        }
+        return sum;
+    }
+
+    SweepResult sweep(int64_t qty) const {
+        SweepResult result;
+        for (auto it = levels.begin(); it != levels.end() && result.filled < qty; ++it) {
+            int64_t take = std::min(qty - result.filled, it->second.depth);
+            if (take <= 0) continue;
+            result.filled += take;
+            result.cost += take * it->first;
+            result.lastPrice = it->first;
+        }
+        return result;
+    }
+};
+
+struct MapBackend {
+    template <typename Level, bool IsBid>
+    using Side = MapBookSide<Level, IsBid>;
+};
+
+struct LadderBackend {
+    template <typename Level, bool IsBid>
+    using Side = PriceLadder<Level, IsBid>;
+};
+
+#endif
@@ -0,0 +1,83 @@
+# Compile the exchange order book demo
+g++ -std=c++20 -O3 Exchange_OrderBook.cpp -o exchange_orderbook -pthread
+
+# Compile the interactive HFT order book
+g++ -std=c++20 -O3 HFT_company_OrderBook.cpp -o hft_orderbook -pthread
+
+# Compile the price-level backend benchmark (std::map vs ladder)
+g++ -std=c++20 -O3 bench_price_ladder.cpp -o bench_price_ladder
+
+# Compile the logging benchmark with logging compiled in and compiled out
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_DEBUG bench_logging.cpp -o bench_logging_on -pthread
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_logging.cpp -o bench_logging_off -pthread
+
+# Compile the command journal record/replay benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_journal.cpp -o bench_journal -pthread
+
+# Compile the snapshot stall benchmark (blocking vs background write)
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_snapshot.cpp -o bench_snapshot -pthread
+
+# Compile the multi-symbol engine benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_symbols.cpp -o bench_symbols -pthread
+
+# Compile the gateway -> sequencer ingress benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_sequencer.cpp -o bench_sequencer -pthread
+
+# Compile the batched order entry benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_batch.cpp -o bench_batch -pthread
+
+# Compile the L2 market-data feed benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_market_data.cpp -o bench_market_data -pthread
+
+# Compile the L3 feed / book builder benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_l3.cpp -o bench_l3 -pthread
+
+# Compile the seqlock top-of-book benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_top_of_book.cpp -o bench_top_of_book -pthread
+
+# Compile the trade store spill / query benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_trade_store.cpp -o bench_trade_store -pthread
+
+# Compile the trade analytics (bars / VWAP / rolling volume) benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_analytics.cpp -o bench_analytics -pthread
+
+# Compile the client position / PnL benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_positions.cpp -o bench_positions -pthread
+
+# Compile the hot/cold order layout sweep benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_order_layout.cpp -o bench_order_layout -pthread
+
+# Compile the order-ID index footprint benchmark (index vs unordered_map)
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_order_index.cpp -o bench_order_index -pthread
+
+# Compile the finished-order archive benchmark (live pool vs lifetime orders)
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_order_archive.cpp -o bench_order_archive -pthread
+
+# Compile the per-stage latency / histogram benchmark
+g++ -std=c++20 -O3 -DOB_LOG_LEVEL=OB_LEVEL_OFF bench_latency.cpp -o bench_latency -pthread
+
+# Compile the engine behavior tests
+g++ -std=c++20 -O2 -DOB_LOG_LEVEL=OB_LEVEL_OFF test_engine.cpp -o test_engine -pthread
+
+# Run tests
+./test_engine || exit 1
+
+# Run benchmarks (the ones that cross-check results stop the build on a mismatch)
+./bench_price_ladder
+./bench_logging_on
+./bench_logging_off
+./bench_journal || exit 1
+./bench_snapshot || exit 1
+./bench_symbols || exit 1
+./bench_sequencer || exit 1
+./bench_batch || exit 1
+./bench_market_data || exit 1
+./bench_l3 || exit 1
+./bench_top_of_book || exit 1
+./bench_trade_store || exit 1
+./bench_analytics || exit 1
+./bench_positions
+./bench_order_layout
+./bench_order_index
+./bench_order_archive
+./bench_latency
@@ -0,0 +1,362 @@
+#ifndef COMMAND_JOURNAL_H
+#define COMMAND_JOURNAL_H
+
+// Append-only binary journal of the commands the engine accepted. Records are
+// fixed-size and written straight into a memory-mapped file; durability is
+// group-committed by a background flusher thread (fdatasync, which also writes
+// back pages dirtied through the mapping), so appending never waits for the
+// disk and a burst of commands shares one flush. The appending thread asks
+// for a commit every syncEvery records or syncInterval of command time,
+// whichever comes first; the flusher then makes everything appended so far
+// durable and advances durableSeq(), which is what a caller must wait on
+// before acknowledging a command as persisted. Both limits are checked as
+// records arrive, so after the last command before a quiet spell, the
+// appending thread must call flushIfDue() while idle (the engine's
+// flushJournalIfDue) to keep syncInterval a real bound. Replaying the
+// records in order through the engine rebuilds its state exactly.
+//
+// File layout: one header page, then records back to back. The file grows in
+// chunkBytes steps; unused space is zero, and a record with seq 0 or a bad
+// checksum marks the end (a torn write is simply dropped on reopen).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "async_logger.h"
+
+enum class CommandType : uint8_t {
+    PLACE = 1,
+    CANCEL = 2,
+    MODIFY = 3,
+    SET_FEES = 4,
+    SET_TICK_SIZE = 5,
+    BATCH_BEGIN = 6, // the commands up to BATCH_END were applied as one batch
+    BATCH_END = 7
+};
+
+// Longest client ID the engine accepts, in bytes. Order entry rejects longer
+// ones, so every ID fits a record whole and replay interns the same clients.
+inline constexpr size_t MAX_CLIENT_ID_BYTES = 71;
+
+struct JournalRecord {
+    uint64_t seq;       // 1-based, assigned by append()
+    int64_t timestamp;  // command time, ns since the Unix epoch
+    uint8_t command;    // CommandType
+    uint8_t orderType;  // PLACE
+    uint8_t side;       // PLACE: 0 = buy, 1 = sell
+    uint8_t reserved0;
+    int32_t orderId;    // CANCEL / MODIFY target
+    double price;       // PLACE / MODIFY; SET_FEES: maker; SET_TICK_SIZE: price tick
+    double quantity;    // PLACE / MODIFY; SET_FEES: taker; SET_TICK_SIZE: quantity tick
+    double stopPrice;   // PLACE
+    char clientId[MAX_CLIENT_ID_BYTES + 1]; // PLACE, NUL-terminated
+    uint32_t reserved1;
+    uint32_t checksum;  // FNV-1a of everything before it
+
+    // id must be at most MAX_CLIENT_ID_BYTES long (validated at order entry).
+    void setClientId(std::string_view id) {
+        std::memset(clientId, 0, sizeof(clientId));
+        std::memcpy(clientId, id.data(), std::min(id.size(), MAX_CLIENT_ID_BYTES));
+    }
+
+    uint32_t computeChecksum() const {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(this);
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < offsetof(JournalRecord, checksum); ++i) hash = (hash ^ bytes[i]) * 16777619u;
+        return hash;
+    }
+
+    bool valid() const { return seq != 0 && checksum == computeChecksum(); }
+};
+static_assert(sizeof(JournalRecord) == 128);
+
+struct JournalHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+};
+
+struct JournalConfig {
+    size_t syncEvery = 64;                                // records per group commit
+    std::chrono::microseconds syncInterval{1000};         // max age of an uncommitted record
+    size_t chunkBytes = 64 << 20;                         // file growth step
+};
+
+struct JournalStats {
+    uint64_t records = 0;
+    uint64_t syncs = 0;      // group commits the flusher completed
+    uint64_t durableSeq = 0; // last seq known to be on stable storage
+};
+
+inline constexpr char JOURNAL_MAGIC[8] = {'O', 'B', 'J', 'R', 'N', 'L', '\0', '\0'};
+inline constexpr uint32_t JOURNAL_VERSION = 1;
+inline constexpr size_t JOURNAL_HEADER_BYTES = 4096;
+
+class CommandJournal {
+private:
+    int fd = -1;
+    JournalConfig config;
+    unsigned char* chunk = nullptr; // mapped window of the file being appended
+    size_t chunkIndex = 0;
+    size_t slot = 0;                // next record within the chunk
+    size_t pending = 0;             // records appended since the last commit request
+    int64_t firstPendingTime = 0;
+    uint64_t nextSeq = 1;
+    uint64_t records = 0;
+
+    // Flusher handshake: the appender raises `requested` to the last seq it
+    // wants committed (STOP set on close); the flusher syncs and raises
+    // `durable` to the last seq written before that sync.
+    static constexpr uint64_t STOP = uint64_t(1) << 63;
+    alignas(64) std::atomic<uint64_t> requested{0};
+    alignas(64) std::atomic<uint64_t> durable{0};
+    std::atomic<uint64_t> syncs{0};
+    std::thread flusher;
+
+    void flushLoop() {
+        uint64_t done = durable.load(std::memory_order_relaxed);
+        for (uint64_t seen = requested.load(std::memory_order_acquire);;
+             seen = requested.load(std::memory_order_acquire)) {
+            uint64_t target = seen & ~STOP;
+            if (target > done) {
+                if (fdatasync(fd) != 0) {
+                    OB_LOG_ERROR("❌ Journal sync failed; retrying");
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    continue;
+                }
+                done = target;
+                syncs.fetch_add(1, std::memory_order_relaxed);
+                durable.store(done, std::memory_order_release);
+                durable.notify_all();
+            } else if (seen & STOP) {
+                return;
+            } else {
+                requested.wait(seen, std::memory_order_acquire);
+            }
+        }
+    }
+
+    // Asks the flusher to commit every record appended so far.
+    void requestCommit() {
+        pending = 0;
+        requested.store(nextSeq - 1, std::memory_order_release);
+        requested.notify_one();
+    }
+
+    size_t recordsPerChunk() const { return config.chunkBytes / sizeof(JournalRecord); }
+    off_t chunkOffset(size_t index) const { return off_t(JOURNAL_HEADER_BYTES + index * config.chunkBytes); }
+
+    bool mapChunk(size_t index) {
+        if (chunk) munmap(chunk, config.chunkBytes);
+        chunk = nullptr;
+        off_t end = chunkOffset(index + 1);
+        struct stat st;
+        if (fstat(fd, &st) != 0) return false;
+        if (st.st_size < end && ftruncate(fd, end) != 0) return false;
+        void* p = mmap(nullptr, config.chunkBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, chunkOffset(index));
+        if (p == MAP_FAILED) return false;
+        chunk = static_cast<unsigned char*>(p);
+        chunkIndex = index;
+        return true;
+    }
+
+    JournalRecord* at(size_t i) { return reinterpret_cast<JournalRecord*>(chunk + i * sizeof(JournalRecord)); }
+
+    // Finds the end of an existing journal so appends continue after it.
+    bool resume() {
+        for (size_t index = 0;; ++index) {
+            if (!mapChunk(index)) return false;
+            for (size_t i = 0; i < recordsPerChunk(); ++i) {
+                const JournalRecord* record = at(i);
+                if (!record->valid() || record->seq != nextSeq) {
+                    std::memset(at(i), 0, (recordsPerChunk() - i) * sizeof(JournalRecord)); // drop any torn tail
+                    slot = i;
+                    durable.store(nextSeq - 1, std::memory_order_relaxed);
+                    requested.store(nextSeq - 1, std::memory_order_relaxed);
+                    return true;
+                }
+                nextSeq++;
+            }
+        }
+    }
+
+    void close() {
+        if (chunk) {
+            sync();
+            munmap(chunk, config.chunkBytes);
+            chunk = nullptr;
+        }
+        if (flusher.joinable()) {
+            requested.fetch_or(STOP, std::memory_order_release);
+            requested.notify_one();
+            flusher.join();
+        }
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+public:
+    explicit CommandJournal(const std::string& path, const JournalConfig& config_ = {}) : config(config_) {
+        long page = sysconf(_SC_PAGESIZE);
+        config.chunkBytes = std::max<size_t>(page, config.chunkBytes / page * page);
+
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            OB_LOG_ERROR("❌ Cannot open journal %s", path);
+            return;
+        }
+        JournalHeader header{};
+        struct stat st;
+        fstat(fd, &st);
+        if (st.st_size == 0) {
+            std::memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+            header.version = JOURNAL_VERSION;
+            header.recordSize = sizeof(JournalRecord);
+            if (pwrite(fd, &header, sizeof(header), 0) != ssize_t(sizeof(header))) {
+                OB_LOG_ERROR("❌ Cannot write journal header %s", path);
+                close();
+                return;
+            }
+        } else if (pread(fd, &header, sizeof(header), 0) != ssize_t(sizeof(header)) ||
+                   std::memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0 ||
+                   header.version != JOURNAL_VERSION || header.recordSize != sizeof(JournalRecord)) {
+            OB_LOG_ERROR("❌ %s is not a compatible journal", path);
+            close();
+            return;
+        }
+        if (!resume()) {
+            OB_LOG_ERROR("❌ Cannot map journal %s", path);
+            close();
+            return;
+        }
+        flusher = std::thread([this] { flushLoop(); });
+    }
+
+    ~CommandJournal() { close(); }
+
+    CommandJournal(const CommandJournal&) = delete;
+    CommandJournal& operator=(const CommandJournal&) = delete;
+
+    bool isOpen() const { return chunk != nullptr; }
+    uint64_t lastSeq() const { return nextSeq - 1; }
+
+    // Any thread: the last seq on stable storage. Commands up to it survive a
+    // crash; later ones may not.
+    uint64_t durableSeq() const { return durable.load(std::memory_order_acquire); }
+
+    JournalStats getStats() const {
+        return JournalStats{records, syncs.load(std::memory_order_relaxed), durableSeq()};
+    }
+
+    // Stamps seq and checksum, copies the record into the map and asks the
+    // flusher to commit the group once it is full or old enough; never waits
+    // for the disk. Returns the seq, or 0 if closed.
+    uint64_t append(JournalRecord& record) {
+        if (!chunk) return 0;
+        if (slot == recordsPerChunk()) {
+            // Unmapping keeps the dirty pages in the page cache for the flusher.
+            if (pending) requestCommit();
+            if (!mapChunk(chunkIndex + 1)) {
+                OB_LOG_ERROR("❌ Journal full: cannot extend file");
+                close();
+                return 0;
+            }
+            slot = 0;
+        }
+        record.seq = nextSeq++;
+        record.checksum = record.computeChecksum();
+        std::memcpy(at(slot++), &record, sizeof(record));
+        if (pending++ == 0) firstPendingTime = record.timestamp;
+        records++;
+
+        auto pendingTime = std::chrono::nanoseconds(record.timestamp - firstPendingTime);
+        if (pending >= config.syncEvery || pendingTime >= config.syncInterval) requestCommit();
+        return record.seq;
+    }
+
+    // Asks for a commit of the pending group if its first record is
+    // syncInterval old at `now` (ns, the clock record timestamps use). For the
+    // appending thread's idle loop; returns true if it asked.
+    bool flushIfDue(int64_t now) {
+        if (!chunk || !pending) return false;
+        if (std::chrono::nanoseconds(now - firstPendingTime) < config.syncInterval) return false;
+        requestCommit();
+        return true;
+    }
+
+    // Commits every record appended so far and waits until it is durable.
+    // Blocks for a full fdatasync: for shutdown and tests, not the hot path.
+    void sync() {
+        if (!chunk) return;
+        uint64_t target = nextSeq - 1;
+        if (pending) requestCommit();
+        for (uint64_t seen = durableSeq(); seen < target; seen = durableSeq()) durable.wait(seen);
+    }
+};
+
+// Read-only view of a journal for replay. Maps the whole file at once.
+class JournalReader {
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+
+public:
+    explicit JournalReader(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && size_t(st.st_size) > JOURNAL_HEADER_BYTES) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                data = static_cast<const unsigned char*>(p);
+                size = st.st_size;
+                const JournalHeader* header = reinterpret_cast<const JournalHeader*>(data);
+                if (std::memcmp(header->magic, JOURNAL_MAGIC, sizeof(header->magic)) != 0 ||
+                    header->version != JOURNAL_VERSION || header->recordSize != sizeof(JournalRecord)) {
+                    munmap(p, size);
+                    data = nullptr;
+                    size = 0;
+                }
+            }
+        }
+        ::close(fd);
+    }
+
+    ~JournalReader() {
+        if (data) munmap(const_cast<unsigned char*>(data), size);
+    }
+
+    JournalReader(const JournalReader&) = delete;
+    JournalReader& operator=(const JournalReader&) = delete;
+
+    bool isOpen() const { return data != nullptr; }
+
+    // Calls f(record) for each intact record in sequence order; stops at the
+    // first gap, torn record or the end of the written part.
+    template <typename F>
+    uint64_t forEach(F&& f) const {
+        uint64_t expected = 1;
+        for (size_t offset = JOURNAL_HEADER_BYTES; offset + sizeof(JournalRecord) <= size;
+             offset += sizeof(JournalRecord)) {
+            const JournalRecord* record = reinterpret_cast<const JournalRecord*>(data + offset);
+            if (!record->valid() || record->seq != expected) break;
+            f(*record);
+            expected++;
+        }
+        return expected - 1;
+    }
+};
+
+#endif
@@ -0,0 +1,1725 @@
+#ifndef EXCHANGE_ORDERBOOK_H
+#define EXCHANGE_ORDERBOOK_H
+
+// Exchange-style matching engine (price-time priority, fixed-point prices and
+// quantities). The demo lives in Exchange_OrderBook.cpp; benchmarks include
+// this header directly.
+
+#include <iostream>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <queue>
+#include <iomanip>
+#include <unordered_map>
+#include <functional>
+#include <sstream>
+#include <cmath>
+#include <numeric>
+#include <optional>
+#include <ctime>
+#include <cstdint>
+#include <span>
+
+#include "async_logger.h"
+#include "book_side.h"
+#include "command_journal.h"
+#include "intrusive_fifo.h"
+#include "latency_stats.h"
+#include "market_data.h"
+#include "object_pool.h"
+#include "order_archive.h"
+#include "order_index.h"
+#include "seqlock.h"
+#include "snapshot_format.h"
+#include "snapshot_writer.h"
+#include "trade_analytics.h"
+#include "trade_store.h"
+
+using namespace std;
+
+enum OrderType : uint8_t { LIMIT, MARKET, STOP, IOC, FOK };
+enum OrderStatus : uint8_t { OPEN, PARTIAL, FILLED, CANCELLED, REJECTED };
+enum OrderSide : uint8_t { BUY, SELL };
+
+inline const char* sideName(OrderSide side) { return side == BUY ? "buy" : "sell"; }
+
+// Prices are stored as whole ticks (multiples of minPrice) and quantities as whole
+// lots (multiples of minQty). Doubles only appear at the API edge.
+using Ticks = int64_t;
+using Lots = int64_t;
+
+// The part of an order that matching, the book and the feeds touch: one
+// cache line, so a sweep through a deep level reads one line per order. The
+// rest lives in its OrderCold entry (see orderDetails).
+struct alignas(CACHE_LINE_SIZE) Order {
+    int id;
+    OrderSide side;
+    OrderType type;
+    OrderStatus status;
+    bool resting = false; // linked into a book level
+    Ticks price;
+    Lots quantity;
+    Lots filledQty;
+    chrono::system_clock::time_point timestamp; // time priority
+    uint32_t handle = 0; // slot in the engine's order pool, also its cold entry
+    uint32_t client = 0; // interned clientId (0: none), indexes the positions
+
+    // Links in its price level's FIFO while resting in the book (or in its
+    // stop level while a pending stop).
+    Order* prev = nullptr;
+    Order* next = nullptr;
+};
+static_assert(sizeof(Order) == CACHE_LINE_SIZE);
+
+// Order fields only entry, stops, reports and snapshots read, kept by the
+// engine in a table indexed by the order's pool handle.
+struct OrderCold {
+    string clientId;
+    Ticks stopPrice = 0;
+    chrono::nanoseconds latency{0}; // received -> events published, for the command that placed it
+};
+
+using OrderQueue = IntrusiveFifo<Order>;
+
+// A book level: its FIFO plus aggregates kept up to date on every insert, fill
+// and cancel, so depth queries read them instead of summing the orders.
+struct PriceLevel {
+    OrderQueue orders;
+    Lots openQty = 0;
+    uint32_t orderCount = 0;
+
+    void clear() {
+        orders.clear();
+        openQty = 0;
+        orderCount = 0;
+    }
+};
+
+struct Trade {
+    int buyOrderId;
+    int sellOrderId;
+    Ticks price;
+    Lots quantity;
+    chrono::system_clock::time_point timestamp;
+    double fee;
+};
+
+// Preallocated capacities for the engine's pools. With GROW the pools add
+// slabs past these sizes (visible in the stats); with REJECT new orders are
+// refused, and with OVERWRITE the trade store keeps only the newest trades.
+// A trade spill directory bounds trade memory at tradeCapacity (plus one chunk
+// being written) and moves older trades to disk instead (see TradeStore).
+// Finished orders leave the pool for the order archive, which likewise keeps
+// archiveCapacity records in memory and the rest in orderArchiveFile when one
+// is given (without a file, archiveOverflow OVERWRITE keeps only the newest).
+struct PoolConfig {
+    size_t orderCapacity = 1 << 16;
+    size_t tradeCapacity = 1 << 16;
+    OverflowPolicy orderOverflow = OverflowPolicy::GROW;
+    OverflowPolicy tradeOverflow = OverflowPolicy::GROW;
+    string tradeSpillDir = {};
+    size_t archiveCapacity = 1 << 16;
+    string orderArchiveFile = {};
+    OverflowPolicy archiveOverflow = OverflowPolicy::GROW;
+};
+
+struct DepthLevel {
+    Ticks price;
+    Lots quantity;
+    uint32_t orders;
+    double notional;
+};
+
+// The touch as published for other threads (see readTopOfBook). A side with
+// no orders has price, quantity and order count 0.
+struct TopOfBook {
+    Ticks bidPrice;
+    Lots bidQty;
+    Ticks askPrice;
+    Lots askQty;
+    uint32_t bidOrders;
+    uint32_t askOrders;
+    uint64_t sequence;  // 1 for the first change, then +1 per change
+    int64_t timestamp;  // command time of the change, ns since the Unix epoch
+};
+static_assert(sizeof(TopOfBook) + sizeof(uint64_t) <= CACHE_LINE_SIZE);
+
+// What a marketable order of a given size would do against the book right now.
+struct ImpactEstimate {
+    double filledQty;
+    double avgPrice;   // 0 when nothing would fill
+    double worstPrice; // deepest level reached
+    double cost;       // notional before fees
+};
+
+// Per client, in ticks and lots. Average-cost accounting: avgPrice is the
+// entry price of the open quantity, and fills that reduce it realize PnL
+// against that price.
+struct Position {
+    Lots quantity = 0;        // + long, - short
+    double avgPrice = 0.0;    // ticks
+    double realizedPnl = 0.0; // ticks x lots
+    double feesPaid = 0.0;    // fees charged on the client's trades
+    uint64_t fills = 0;
+};
+
+// A client's position in price and quantity units, valued at the mark: the
+// mid at the last top-of-book change (the last trade price before the book
+// was ever two-sided). Exposures are for this book's instrument only.
+struct PositionReport {
+    double quantity;
+    double avgPrice;
+    double realizedPnl;
+    double unrealizedPnl;
+    double feesPaid;
+    double netExposure;   // quantity x mark
+    double grossExposure; // |quantity| x mark
+    uint64_t fills;
+};
+
+// One entry of a placeOrders() burst; same fields as placeOrder's arguments.
+struct OrderRequest {
+    string side;
+    double price;
+    double quantity;
+    OrderType type;
+    string clientId;
+    double stopPrice = 0.0;
+};
+
+// Event sink the book calls directly, so handlers inline into matching instead
+// of going through type-erased callbacks. Derive from NullSink and hide the
+// hooks you need; the book is passed in so handlers can convert units or query
+// it, but they must not modify it.
+//
+// With batchExecutions set, fills are collected while one aggressor matches
+// and delivered as a single onExecutions span when its matching ends; onTrade
+// is then not called.
+struct NullSink {
+    static constexpr bool batchExecutions = false;
+
+    template <typename Book> void onTrade(const Book&, const Trade&) {}
+    template <typename Book> void onExecutions(const Book&, span<const Trade>) {}
+    template <typename Book> void onOrder(const Book&, const Order&) {}
+};
+
+// Backend picks the price-level storage: LadderBackend (default, direct-indexed
+// array + occupancy bitmap) or MapBackend (std::map, kept for comparison).
+// Sink receives trade and order events (see NullSink).
+//
+// Orders live in orderPool and orderIndex maps each ID to its slot; price
+// levels only link the resting ones, so an order ID leads straight to its
+// queue node and cancels never scan the book.
+template <typename Backend = LadderBackend, typename Sink = NullSink>
+class BasicOrderBook {
+private:
+    typename Backend::template Side<PriceLevel, true> bids;
+    typename Backend::template Side<PriceLevel, false> asks;
+    // Pending stops keyed by stop price in trigger order: buy stops fire from
+    // the lowest stop up, sell stops from the highest down.
+    typename Backend::template Side<OrderQueue, false> buyStops;
+    typename Backend::template Side<OrderQueue, true> sellStops;
+    vector<Order*> stopActivations;
+    bool activatingStops = false;
+    SlabPool<Order> orderPool;
+    vector<OrderCold> orderCold; // indexed by pool handle, alongside orderPool
+    // Orders that finished during the current command. They leave the pool
+    // and index for the archive when the next command starts, so nothing
+    // still working on them mid-command sees a released slot.
+    vector<uint32_t> retiring;
+    OrderArchive archive;
+    OrderIndex orderIndex;
+    // Client IDs are interned at order entry and positions indexed by the
+    // result, so a fill updates two array slots without hashing anything.
+    // Index 0 is the empty client ID, which keeps no position.
+    unordered_map<string, uint32_t> clientIndex;
+    vector<string> clientNames{string()};
+    vector<Position> positions{Position{}};
+    double markPrice = 0.0; // ticks; see PositionReport
+    TradeStore tradeHistory;
+    int orderCounter = 0;
+    optional<Ticks> bestBid;
+    optional<Ticks> bestAsk;
+    TopOfBook touch{};           // last published, matching thread's copy
+    SeqLock<TopOfBook> topOfBook; // what other threads read
+    double makerFee = 0.001;
+    double takerFee = 0.002;
+    double minPrice = 0.01;
+    double minQty = 0.00001;
+    const double EPSILON = 1e-6;
+    // Stage times of the command in progress; see latency_stats.h. Orders a
+    // command creates get its end-to-end latency.
+    LatencyRecorder latency;
+    int commandFirstId = 0;
+
+    Sink sink;
+    vector<Trade> pendingExecutions; // batchExecutions only
+
+    CommandJournal* journal = nullptr;
+    SnapshotWriter<BasicOrderBook<Backend, NullSink>>* snapshotWriter = nullptr;
+    MarketDataPublisher* marketData = nullptr;
+    OrderFeedPublisher* orderFeed = nullptr;
+    TradeAnalytics* analytics = nullptr;
+    // Time of the public command being processed. Every order and trade it
+    // creates is stamped with it, so a replay reproduces them exactly.
+    chrono::system_clock::time_point commandTime;
+    SnapshotBuilder snapshotImage; // reused so captures stop allocating once warm
+
+    // Inside placeOrders/cancelOrders: top of book and stop triggering are
+    // deferred to the end of the burst; the trade price range seen meanwhile
+    // decides which stops fire then.
+    bool inBatch = false;
+    bool batchTraded = false;
+    Ticks batchHigh = 0;
+    Ticks batchLow = 0;
+    // Kept here rather than read back from the trade store, which stops
+    // recording once full under OverflowPolicy::REJECT. 0: no trade yet.
+    Ticks lastTradePrice = 0;
+
+    static int64_t toNanos(chrono::system_clock::time_point tp) {
+        return chrono::duration_cast<chrono::nanoseconds>(tp.time_since_epoch()).count();
+    }
+
+    static chrono::system_clock::time_point fromNanos(int64_t ns) {
+        return chrono::system_clock::time_point(chrono::duration_cast<chrono::system_clock::duration>(chrono::nanoseconds(ns)));
+    }
+
+    static StoredTrade toStored(const Trade& t) {
+        return StoredTrade{toNanos(t.timestamp), t.price, t.quantity, t.buyOrderId, t.sellOrderId, t.fee};
+    }
+
+    static Trade fromStored(const StoredTrade& t) {
+        return Trade{t.buyOrderId, t.sellOrderId, t.price, t.quantity, fromNanos(t.timestamp), t.fee};
+    }
+
+    void beginCommand(chrono::system_clock::time_point at = chrono::system_clock::now()) {
+        retireOrders();
+        commandTime = at;
+        commandFirstId = orderCounter + 1;
+    }
+
+    // An order command (place, modify, cancel or a burst of them): starts its
+    // latency clock, which endCommand stops. Config commands use beginCommand
+    // alone and are not measured.
+    void beginTimedCommand(chrono::system_clock::time_point at = chrono::system_clock::now()) {
+        latency.begin();
+        beginCommand(at);
+    }
+
+    // Once the command's events are out: records its stage times.
+    void endCommand(bool batch = false) {
+        chrono::nanoseconds elapsed(latency.end(batch));
+        if constexpr (!OB_LATENCY_STATS) return;
+        for (int id = commandFirstId; id <= orderCounter; ++id) {
+            if (Order* order = findOrder(id)) cold(*order).latency = elapsed;
+        }
+    }
+
+    // Write-ahead: called once a command is accepted, before it changes the book.
+    // The snapshot writer's mirror gets the same record.
+    void journalCommand(JournalRecord& record) {
+        if (!journal && !snapshotWriter) return;
+        record.timestamp = toNanos(commandTime);
+        if (journal) journal->append(record);
+        if (snapshotWriter) snapshotWriter->mirrorCommand(record);
+    }
+
+    void updateMarketData() {
+        if (marketData) marketData->flush();
+        if (inBatch) return;
+        if (analytics) analytics->publish(toNanos(commandTime));
+        bestBid = bids.empty() ? optional<Ticks>{} : bids.bestPrice();
+        bestAsk = asks.empty() ? optional<Ticks>{} : asks.bestPrice();
+        publishTopOfBook();
+    }
+
+    // Publishes the touch to other threads when price, size or order count
+    // changed on either side.
+    void publishTopOfBook() {
+        TopOfBook next{};
+        if (!bids.empty()) {
+            const PriceLevel& level = bids.best();
+            next.bidPrice = bids.bestPrice();
+            next.bidQty = level.openQty;
+            next.bidOrders = level.orderCount;
+        }
+        if (!asks.empty()) {
+            const PriceLevel& level = asks.best();
+            next.askPrice = asks.bestPrice();
+            next.askQty = level.openQty;
+            next.askOrders = level.orderCount;
+        }
+        if (next.bidPrice == touch.bidPrice && next.bidQty == touch.bidQty && next.bidOrders == touch.bidOrders &&
+            next.askPrice == touch.askPrice && next.askQty == touch.askQty && next.askOrders == touch.askOrders)
+            return;
+        if (next.bidOrders && next.askOrders) markPrice = double(next.bidPrice + next.askPrice) / 2.0;
+        next.sequence = touch.sequence + 1;
+        next.timestamp = toNanos(commandTime);
+        touch = next;
+        topOfBook.store(touch);
+    }
+
+    static bool isFinished(OrderStatus status) { return status == FILLED || status == CANCELLED || status == REJECTED; }
+
+    void updateOrderStatus(Order& order, OrderStatus status, Lots filledQty = 0) {
+        if (!isFinished(order.status) && isFinished(status)) retiring.push_back(order.handle);
+        order.status = status;
+        order.filledQty += filledQty;
+        sink.onOrder(*this, order);
+    }
+
+    void updateOrderStatus(int orderId, OrderStatus status, Lots filledQty = 0) {
+        if (Order* order = findOrder(orderId)) updateOrderStatus(*order, status, filledQty);
+    }
+
+    // Allocates an order and fills in its cold entry; INVALID if the pool is full.
+    uint32_t allocateOrder(const Order& order, OrderCold details) {
+        uint32_t handle = orderPool.allocate(order);
+        if (handle == SlabPool<Order>::INVALID) return handle;
+        if (handle >= orderCold.size()) orderCold.resize(orderPool.getStats().capacity);
+        orderPool[handle].handle = handle;
+        orderCold[handle] = std::move(details);
+        return handle;
+    }
+
+    OrderCold& cold(const Order& order) { return orderCold[order.handle]; }
+
+    Order* findOrder(int orderId) {
+        uint32_t handle = orderIndex.find(orderId);
+        return handle == OrderIndex::NONE ? nullptr : &orderPool[handle];
+    }
+
+    ArchivedOrder toArchived(const Order& order) {
+        const OrderCold& details = cold(order);
+        return ArchivedOrder{order.price, order.quantity, order.filledQty, details.stopPrice, toNanos(order.timestamp),
+                             details.latency.count(), order.id, order.client, uint8_t(order.side), uint8_t(order.type),
+                             uint8_t(order.status), {}};
+    }
+
+    void retireOrders() {
+        for (uint32_t handle : retiring) {
+            const Order& order = orderPool[handle];
+            archive.append(toArchived(order));
+            orderIndex.erase(order.id);
+            orderCold[handle] = OrderCold{};
+            orderPool.release(handle);
+        }
+        retiring.clear();
+    }
+
+    void releaseAllOrders() {
+        orderIndex.forEach([&](int, uint32_t handle) {
+            orderCold[handle] = OrderCold{};
+            orderPool.release(handle);
+        });
+        orderIndex.clear();
+        retiring.clear();
+    }
+
+    // Every change to a resting order's open quantity goes through these three,
+    // which keeps the level aggregates and the side's depth index exact and
+    // reports the change to the L2 (level) and L3 (order) feeds.
+    template <typename Side>
+    void publishLevel(Ticks price, const PriceLevel& level, LevelAction action) {
+        if (!marketData) return;
+        constexpr uint8_t side = is_same_v<Side, decltype(bids)> ? 0 : 1;
+        marketData->publish(toNanos(commandTime), side, action, price, level.openQty, level.orderCount);
+    }
+
+    template <typename Side>
+    void publishOrderEvent(OrderEventType type, const Order& order, Ticks price, Lots quantity) {
+        if (!orderFeed) return;
+        constexpr uint8_t side = is_same_v<Side, decltype(bids)> ? 0 : 1;
+        orderFeed->publish(toNanos(commandTime), type, side, order.id, price, quantity);
+    }
+
+    template <typename Side>
+    void addToLevel(Side& book, PriceLevel& level, Order& order) {
+        Lots open = order.quantity - order.filledQty;
+        level.orders.push_back(&order);
+        level.openQty += open;
+        level.orderCount++;
+        book.addDepth(order.price, open);
+        order.resting = true;
+        publishOrderEvent<Side>(OrderEventType::ADD, order, order.price, open);
+        publishLevel<Side>(order.price, level, level.orderCount == 1 ? LevelAction::ADD : LevelAction::CHANGE);
+    }
+
+    template <typename Side>
+    void removeFromLevel(Side& book, PriceLevel& level, Order& order, bool publish = true) {
+        Lots open = order.quantity - order.filledQty;
+        level.orders.erase(&order);
+        level.openQty -= open;
+        level.orderCount--;
+        book.addDepth(order.price, -open);
+        order.resting = false;
+        if (publish) {
+            publishOrderEvent<Side>(OrderEventType::DELETE, order, order.price, open);
+            publishLevel<Side>(order.price, level, level.orderCount == 0 ? LevelAction::DELETE : LevelAction::CHANGE);
+        }
+    }
+
+    // Unlinks the order once it is completely filled; one update either way.
+    template <typename Side>
+    void fillAtLevel(Side& book, PriceLevel& level, Order& order, Lots qty, Ticks tradePrice) {
+        publishOrderEvent<Side>(OrderEventType::EXECUTE, order, tradePrice, qty);
+        order.filledQty += qty;
+        level.openQty -= qty;
+        book.addDepth(order.price, -qty);
+        if (order.filledQty >= order.quantity) removeFromLevel(book, level, order, false);
+        publishLevel<Side>(order.price, level, level.orderCount == 0 ? LevelAction::DELETE : LevelAction::CHANGE);
+    }
+
+    void restOrder(Order& order) {
+        if (order.side == BUY) addToLevel(bids, bids[order.price], order);
+        else addToLevel(asks, asks[order.price], order);
+    }
+
+    template <typename Side>
+    void unlinkOrder(Side& book, Order& order) {
+        PriceLevel& level = *book.find(order.price);
+        removeFromLevel(book, level, order);
+        if (level.orders.empty()) book.erase(order.price);
+    }
+
+    uint32_t internClient(const string& clientId) {
+        if (clientId.empty()) return 0;
+        auto [it, added] = clientIndex.try_emplace(clientId, uint32_t(clientNames.size()));
+        if (added) {
+            clientNames.push_back(clientId);
+            positions.emplace_back();
+        }
+        return it->second;
+    }
+
+    // One side of a fill; qty is signed (+ bought, - sold). A fill that crosses
+    // zero closes the old position and opens the rest at the trade price.
+    static void applyFill(Position& pos, Lots qty, Ticks price, double fee) {
+        Lots before = pos.quantity;
+        Lots after = before + qty;
+        if (before == 0 || (before > 0) == (qty > 0)) {
+            pos.avgPrice = (double(llabs(before)) * pos.avgPrice + double(llabs(qty)) * double(price)) / double(llabs(after));
+        } else {
+            Lots closed = min(llabs(before), llabs(qty));
+            pos.realizedPnl += double(before > 0 ? closed : -closed) * (double(price) - pos.avgPrice);
+            if (after == 0) pos.avgPrice = 0.0;
+            else if ((after > 0) != (before > 0)) pos.avgPrice = double(price);
+        }
+        pos.quantity = after;
+        pos.feesPaid += fee;
+        pos.fills++;
+    }
+
+    // The trade's fee goes to whichever side the engine charged it to: the
+    // maker on a limit cross (matchOrders passes buyerPays = buyer is the
+    // maker), the taker on a market order.
+    void updatePosition(const Trade& trade, uint32_t buyClient, uint32_t sellClient, bool buyerPays) {
+        if (buyClient) applyFill(positions[buyClient], trade.quantity, trade.price, buyerPays ? trade.fee : 0.0);
+        if (sellClient) applyFill(positions[sellClient], -trade.quantity, trade.price, buyerPays ? 0.0 : trade.fee);
+    }
+
+    // Converts an API-edge value to a whole number of `unit`s. This is the only
+    // place a tolerance is needed; everything past it compares integers.
+    bool toUnits(double value, double unit, int64_t& out) const {
+        double ratio = value / unit;
+        out = llround(ratio);
+        return fabs(ratio - out) <= EPSILON;
+    }
+
+    bool validateOrder(double price, double quantity, OrderType type, double stopPrice,
+                       Ticks& priceTicks, Lots& qtyLots, Ticks& stopTicks) {
+        OB_LOG_DEBUG("Validating: price=%.6f, qty=%.6f, type=%d", price, quantity, int(type));
+        if (quantity <= 0) {
+            OB_LOG_DEBUG("Fail: quantity <= 0");
+            return false;
+        }
+        if (quantity < minQty) {
+            OB_LOG_DEBUG("Fail: quantity < minQty (%.6f)", minQty);
+            return false;
+        }
+        if (!toUnits(quantity, minQty, qtyLots)) {
+            OB_LOG_DEBUG("Fail: quantity not a multiple of minQty (ratio=%.6f)", quantity / minQty);
+            return false;
+        }
+
+        priceTicks = 0;
+        if (type != MARKET && type != STOP) {
+            if (price <= 0) {
+                OB_LOG_DEBUG("Fail: price <= 0");
+                return false;
+            }
+            if (price < minPrice) {
+                OB_LOG_DEBUG("Fail: price < minPrice (%.6f)", minPrice);
+                return false;
+            }
+            if (!toUnits(price, minPrice, priceTicks)) {
+                OB_LOG_DEBUG("Fail: price not a multiple of minPrice (ratio=%.6f)", price / minPrice);
+                return false;
+            }
+        } else if (type == STOP && price > 0 && !toUnits(price, minPrice, priceTicks)) {
+            OB_LOG_DEBUG("Fail: price not a multiple of minPrice (ratio=%.6f)", price / minPrice);
+            return false;
+        }
+
+        stopTicks = 0;
+        if (type == STOP) {
+            if (stopPrice <= 0 || stopPrice < minPrice) {
+                OB_LOG_DEBUG("Fail: stopPrice <= 0 or < minPrice (%.6f)", minPrice);
+                return false;
+            }
+            if (!toUnits(stopPrice, minPrice, stopTicks)) {
+                OB_LOG_DEBUG("Fail: stopPrice not a multiple of minPrice (ratio=%.6f)", stopPrice / minPrice);
+                return false;
+            }
+        }
+        OB_LOG_DEBUG("Validation passed");
+        return true;
+    }
+
+    // Client IDs are journaled whole, so longer ones are refused rather than
+    // truncated into a different client on replay.
+    bool validClientId(const string& clientId) const {
+        if (clientId.size() <= MAX_CLIENT_ID_BYTES) return true;
+        OB_LOG_WARN("❌ Invalid Order: client ID longer than %zu bytes", MAX_CLIENT_ID_BYTES);
+        return false;
+    }
+
+    // validateOrder for BATCH_CHUNK requests at once. The same rules, written
+    // without branches over arrays so the loop vectorizes; rounding uses the
+    // 1.5 * 2^52 trick, which agrees with llround for every ratio within EPSILON
+    // of a whole number. Anything it rejects is re-checked by validateOrder, so
+    // only the rare bad request pays for (and logs) the scalar path.
+    static constexpr size_t BATCH_CHUNK = 64;
+
+    void validateChunk(const OrderRequest* requests, size_t count, Ticks* priceTicks, Lots* qtyLots,
+                       Ticks* stopTicks, bool* ok) const {
+        alignas(64) double price[BATCH_CHUNK], quantity[BATCH_CHUNK], stop[BATCH_CHUNK];
+        alignas(64) uint8_t limitLike[BATCH_CHUNK], isStop[BATCH_CHUNK];
+        for (size_t i = 0; i < count; ++i) {
+            const OrderRequest& r = requests[i];
+            price[i] = r.price;
+            quantity[i] = r.quantity;
+            stop[i] = r.stopPrice;
+            limitLike[i] = r.type == LIMIT || r.type == IOC || r.type == FOK;
+            isStop[i] = r.type == STOP;
+        }
+
+        const double ROUND = 0x1.8p52, RANGE = 0x1p51;
+        const double invPrice = 1.0 / minPrice, invQty = 1.0 / minQty;
+        for (size_t i = 0; i < count; ++i) {
+            double q = quantity[i] * invQty;
+            double qr = (q + ROUND) - ROUND;
+            bool qOk = quantity[i] >= minQty && q < RANGE && fabs(q - qr) <= EPSILON;
+
+            double p = price[i] * invPrice;
+            double pr = (p + ROUND) - ROUND;
+            bool pOnGrid = p < RANGE && fabs(p - pr) <= EPSILON;
+            bool pPositive = price[i] > 0;
+            bool pOk = limitLike[i] ? pPositive && price[i] >= minPrice && pOnGrid : !isStop[i] || !pPositive || pOnGrid;
+
+            double st = stop[i] * invPrice;
+            double sr = (st + ROUND) - ROUND;
+            bool sOk = !isStop[i] || (stop[i] >= minPrice && st < RANGE && fabs(st - sr) <= EPSILON);
+
+            qtyLots[i] = Lots(qr);
+            priceTicks[i] = (limitLike[i] || (isStop[i] && pPositive)) ? Ticks(pr) : 0;
+            stopTicks[i] = isStop[i] ? Ticks(sr) : 0;
+            ok[i] = qOk & pOk & sOk;
+        }
+    }
+
+    // Liquidity an order on `side` can reach, read from the depth index.
+    Lots getAvailableQty(const string& side) {
+        return side == "buy" ? asks.totalDepth() : bids.totalDepth();
+    }
+
+    Lots getAvailableQty(const string& side, Ticks limit) {
+        return side == "buy" ? asks.depthUpTo(limit) : bids.depthUpTo(limit);
+    }
+
+    void publishTrade(const Trade& trade) {
+        if (analytics) analytics->onTrade(toNanos(trade.timestamp), trade.price, trade.quantity);
+        if constexpr (Sink::batchExecutions) pendingExecutions.push_back(trade);
+        else sink.onTrade(*this, trade);
+    }
+
+    // End of one aggressor's matching: hands the collected fills to the sink.
+    void flushExecutions() {
+        if constexpr (Sink::batchExecutions) {
+            if (pendingExecutions.empty()) return;
+            sink.onExecutions(*this, span<const Trade>(pendingExecutions));
+            pendingExecutions.clear();
+        }
+    }
+
+    void noteTrade(Ticks price) {
+        lastTradePrice = price;
+        if (!inBatch) return;
+        batchHigh = batchTraded ? max(batchHigh, price) : price;
+        batchLow = batchTraded ? min(batchLow, price) : price;
+        batchTraded = true;
+    }
+
+    // A batch defers top-of-book and stop triggering to endBatch(). The markers
+    // are journaled so replay defers exactly the same work.
+    void beginBatch(bool journaled) {
+        if (journaled) {
+            JournalRecord record{};
+            record.command = uint8_t(CommandType::BATCH_BEGIN);
+            journalCommand(record);
+        }
+        inBatch = true;
+        batchTraded = false;
+    }
+
+    void endBatch(bool journaled) {
+        if (journaled) {
+            JournalRecord record{};
+            record.command = uint8_t(CommandType::BATCH_END);
+            journalCommand(record);
+        }
+        inBatch = false;
+        updateMarketData();
+        if (batchTraded) checkStopOrders(batchHigh, batchLow);
+    }
+
+    // End of one aggressor: refresh top of book, deliver its executions and
+    // fire any stops its trades crossed. In a batch only the executions go out
+    // now; endBatch() does the rest once.
+    void afterMatching() {
+        latency.markMatched();
+        updateMarketData();
+        flushExecutions();
+        if (!inBatch && lastTradePrice) checkStopOrders(lastTradePrice, lastTradePrice);
+    }
+
+    void armStop(Order& order) {
+        Ticks stopPrice = cold(order).stopPrice;
+        if (order.side == BUY) buyStops[stopPrice].push_back(&order);
+        else sellStops[stopPrice].push_back(&order);
+    }
+
+    template <typename Side>
+    void disarmStop(Side& stops, Order& order) {
+        Ticks stopPrice = cold(order).stopPrice;
+        OrderQueue& level = *stops.find(stopPrice);
+        level.erase(&order);
+        if (level.empty()) stops.erase(stopPrice);
+    }
+
+    // Moves every stop at the trigger-side best level into the activation queue.
+    template <typename Side>
+    void drainStopLevel(Side& stops, Ticks lastPrice) {
+        Ticks stopPrice = stops.bestPrice();
+        OrderQueue& level = stops.best();
+        while (!level.empty()) {
+            Order& order = level.front();
+            level.pop_front();
+            OB_LOG_INFO("✅ Stop Order Triggered [ID:%d]: %s %.6f @ %.6f (Triggered at: %.6f)",
+                        order.id, sideName(order.side), toQty(order.quantity), toPrice(order.price), toPrice(lastPrice));
+            order.type = LIMIT;
+            stopActivations.push_back(&order);
+        }
+        stops.erase(stopPrice);
+    }
+
+    // Buy stops fire at or below the highest trade price, sell stops at or
+    // above the lowest; both are the last price outside a batch.
+    void collectTriggeredStops(Ticks high, Ticks low) {
+        while (!buyStops.empty() && buyStops.bestPrice() <= high) drainStopLevel(buyStops, high);
+        while (!sellStops.empty() && sellStops.bestPrice() >= low) drainStopLevel(sellStops, low);
+    }
+
+    // Only stops crossed by the trade prices are visited. Activations run from a queue
+    // rather than recursing, so a stop cascade cannot grow the stack: trades
+    // made by one activated stop just queue the stops they trigger.
+    void checkStopOrders(Ticks high, Ticks low) {
+        if (activatingStops) return;
+        activatingStops = true;
+        collectTriggeredStops(high, low);
+        for (size_t i = 0; i < stopActivations.size(); ++i) {
+            restOrder(*stopActivations[i]);
+            matchOrders(stopActivations[i]);
+            collectTriggeredStops(lastTradePrice, lastTradePrice);
+        }
+        stopActivations.clear();
+        activatingStops = false;
+    }
+
+    string formatTotal(double total) {
+        if (total >= 1e6) {
+            return to_string(total / 1e6) + "M";
+        } else if (total >= 1e3) {
+            return to_string(total / 1e3) + "K";
+        }
+        return to_string(total);
+    }
+
+    double roundFee(double fee) {
+        return round(fee * 100) / 100;
+    }
+
+    string formatTimestamp(const chrono::system_clock::time_point& tp) {
+        auto time = chrono::system_clock::to_time_t(tp);
+        stringstream ss;
+        ss << put_time(localtime(&time), "%Y-%m-%d %H:%M:%S");
+        return ss.str();
+    }
+
+public:
+    explicit BasicOrderBook(const PoolConfig& pools = {}, Sink sink_ = {})
+        : orderPool(pools.orderCapacity, pools.orderOverflow),
+          archive(pools.archiveCapacity, pools.orderArchiveFile, 4096, pools.archiveOverflow),
+          tradeHistory(pools.tradeCapacity, pools.tradeOverflow, pools.tradeSpillDir),
+          sink(std::move(sink_)) {
+        orderIndex.reserve(pools.orderCapacity);
+        orderCold.resize(orderPool.getStats().capacity);
+        if constexpr (Sink::batchExecutions) pendingExecutions.reserve(256);
+    }
+
+    ~BasicOrderBook() { releaseAllOrders(); }
+
+    int placeOrder(string side, double price, double quantity, OrderType type, string clientId = "", double stopPrice = 0.0) {
+        beginTimedCommand();
+        int id = submitOrder(side, price, quantity, type, clientId, stopPrice, true);
+        endCommand();
+        return id;
+    }
+
+    // Cancels the order and places a new LIMIT one (new ID, back of the queue).
+    // False if the order could not be modified; when the replacement itself is
+    // rejected, the original has been cancelled.
+    bool modifyOrder(int orderId, double newPrice, double newQuantity) {
+        beginTimedCommand();
+        bool modified = submitModify(orderId, newPrice, newQuantity, true);
+        endCommand();
+        return modified;
+    }
+
+    bool cancelOrder(int orderId) {
+        beginTimedCommand();
+        bool cancelled = submitCancel(orderId, true);
+        endCommand();
+        return cancelled;
+    }
+
+    // Places a burst of orders as one command: validation runs over whole
+    // chunks, and top of book and stop triggers are worked out once at the end,
+    // from the highest and lowest price the burst traded at. results[i] gets
+    // the ID placeOrder would have returned for requests[i] (-1 if rejected).
+    // Returns the number accepted.
+    size_t placeOrders(span<const OrderRequest> requests, span<int> results) {
+        if (results.size() < requests.size()) {
+            OB_LOG_ERROR("❌ placeOrders: %zu results for %zu requests", results.size(), requests.size());
+            return 0;
+        }
+        beginTimedCommand();
+        beginBatch(true);
+        size_t accepted = 0;
+        Ticks priceTicks[BATCH_CHUNK], stopTicks[BATCH_CHUNK];
+        Lots qtyLots[BATCH_CHUNK];
+        bool ok[BATCH_CHUNK];
+        for (size_t base = 0; base < requests.size(); base += BATCH_CHUNK) {
+            size_t count = min(BATCH_CHUNK, requests.size() - base);
+            validateChunk(&requests[base], count, priceTicks, qtyLots, stopTicks, ok);
+            for (size_t i = 0; i < count; ++i) {
+                const OrderRequest& r = requests[base + i];
+                if (!ok[i] && !validateOrder(r.price, r.quantity, r.type, r.stopPrice, priceTicks[i], qtyLots[i],
+                                             stopTicks[i])) {
+                    OB_LOG_WARN("❌ Invalid Order: Price/Quantity must be positive and meet tick size");
+                    results[base + i] = -1;
+                    continue;
+                }
+                if (!validClientId(r.clientId)) {
+                    results[base + i] = -1;
+                    continue;
+                }
+                results[base + i] = admitOrder(r.side, r.price, r.quantity, r.type, r.clientId, r.stopPrice,
+                                               priceTicks[i], qtyLots[i], stopTicks[i], true);
+                if (results[base + i] > 0) accepted++;
+            }
+        }
+        endBatch(true);
+        endCommand(true);
+        return accepted;
+    }
+
+    // Cancels a burst of orders, refreshing top of book once at the end.
+    // results[i] is what cancelOrder(ids[i]) would have returned. Cancels never
+    // trade, so they are journaled one by one without batch markers.
+    size_t cancelOrders(span<const int> ids, span<bool> results) {
+        if (results.size() < ids.size()) {
+            OB_LOG_ERROR("❌ cancelOrders: %zu results for %zu IDs", results.size(), ids.size());
+            return 0;
+        }
+        beginTimedCommand();
+        beginBatch(false);
+        size_t cancelled = 0;
+        // Index slots are fetched 16 IDs ahead and the orders 8 ahead, so the
+        // cancels find both in cache.
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i + 16 < ids.size()) orderIndex.prefetch(ids[i + 16]);
+            if (i + 8 < ids.size()) {
+                if (uint32_t handle = orderIndex.find(ids[i + 8]); handle != OrderIndex::NONE)
+                    __builtin_prefetch(&orderPool[handle]);
+            }
+            results[i] = submitCancel(ids[i], true);
+            cancelled += results[i];
+        }
+        endBatch(false);
+        endCommand(true);
+        return cancelled;
+    }
+
+private:
+    // The submit* functions do the work of the public commands. Only the public
+    // entry points journal (journaled = true); modifications, IOC/FOK cleanup and
+    // replay go through here without adding records of their own.
+    int submitOrder(const string& side, double price, double quantity, OrderType type, const string& clientId,
+                    double stopPrice, bool journaled) {
+        Ticks priceTicks, stopTicks;
+        Lots qtyLots;
+        if (!validateOrder(price, quantity, type, stopPrice, priceTicks, qtyLots, stopTicks)) {
+            OB_LOG_WARN("❌ Invalid Order: Price/Quantity must be positive and meet tick size");
+            return -1;
+        }
+        if (!validClientId(clientId)) return -1;
+        latency.markValidated();
+        return admitOrder(side, price, quantity, type, clientId, stopPrice, priceTicks, qtyLots, stopTicks, journaled);
+    }
+
+    // Everything after validation: allocate, journal, then rest/match/arm.
+    int admitOrder(const string& side, double price, double quantity, OrderType type, const string& clientId,
+                   double stopPrice, Ticks priceTicks, Lots qtyLots, Ticks stopTicks, bool journaled) {
+        uint32_t handle = allocateOrder(Order{orderCounter + 1, side == "buy" ? BUY : SELL, type, OPEN, false, priceTicks,
+                                              qtyLots, 0, commandTime},
+                                        OrderCold{clientId, stopTicks});
+        if (handle == SlabPool<Order>::INVALID) {
+            OB_LOG_ERROR("❌ Order Rejected: order pool exhausted (capacity %zu)", orderPool.getStats().capacity);
+            return -1;
+        }
+        orderCounter++;
+        Order& tracked = orderPool[handle];
+        tracked.client = internClient(clientId);
+        orderIndex.insert(orderCounter, handle);
+
+        if (journaled) {
+            JournalRecord record{};
+            record.command = uint8_t(CommandType::PLACE);
+            record.orderType = uint8_t(type);
+            record.side = side == "buy" ? 0 : 1;
+            record.price = price;
+            record.quantity = quantity;
+            record.stopPrice = stopPrice;
+            record.setClientId(clientId);
+            journalCommand(record);
+        }
+
+        if (type == MARKET) {
+            OB_LOG_INFO("✅ Order Placed [ID:%d]: %s %.6f @ N/A (MARKET) Client: %s",
+                        orderCounter, side, quantity, clientId);
+        } else {
+            OB_LOG_INFO("✅ Order Placed [ID:%d]: %s %.6f @ %.6f (%s) Client: %s",
+                        orderCounter, side, quantity, price, type == LIMIT ? "LIMIT" : type == IOC ? "IOC" : "FOK",
+                        clientId);
+        }
+
+        if (type == MARKET) {
+            Lots availableQty = getAvailableQty(side);
+            if (availableQty < qtyLots) {
+                OB_LOG_WARN("⚠️ Warning: Insufficient liquidity for market order. Available: %.6f, Requested: %.6f",
+                            toQty(availableQty), quantity);
+            }
+            double avgPrice = placeMarketOrder(side, qtyLots, tracked.client);
+            if (avgPrice > 0) {
+                OB_LOG_INFO("Market Order Executed [ID:%d]: Avg Price: %.2f", orderCounter, avgPrice);
+            }
+            return orderCounter;
+        } else if (type == STOP) {
+            armStop(tracked);
+            latency.markMatched();
+            OB_LOG_INFO("✅ Stop Order Placed [ID:%d]: %s %.6f @ %.6f (Stop: %.6f) Client: %s",
+                        orderCounter, side, quantity, price, stopPrice, clientId);
+            return orderCounter;
+        }
+
+        restOrder(tracked);
+
+        if (type == LIMIT) matchOrders(&tracked);
+        else if (type == IOC) {
+            matchOrders(&tracked);
+            if (tracked.status == OPEN) submitCancel(orderCounter, false);
+        } else if (type == FOK) {
+            Lots availableQty = getAvailableQty(side, priceTicks);
+            if (availableQty >= qtyLots) matchOrders(&tracked);
+            else {
+                submitCancel(orderCounter, false);
+                updateOrderStatus(tracked, REJECTED);
+                OB_LOG_WARN("❌ FOK Order Rejected: Insufficient liquidity");
+            }
+        }
+
+        latency.markMatched();
+        updateMarketData();
+        return orderCounter;
+    }
+
+    bool submitModify(int orderId, double newPrice, double newQuantity, bool journaled) {
+        Order* existing = findOrder(orderId);
+        if (!existing || existing->status != OPEN) {
+            OB_LOG_WARN("❌ Cannot modify order ID %d: Not found or not open", orderId);
+            return false;
+        }
+        Ticks priceTicks, stopTicks;
+        Lots qtyLots;
+        if (!validateOrder(newPrice, newQuantity, LIMIT, 0.0, priceTicks, qtyLots, stopTicks)) {
+            OB_LOG_WARN("❌ Invalid modification: Price/Quantity invalid");
+            return false;
+        }
+        latency.markValidated();
+
+        if (journaled) {
+            JournalRecord record{};
+            record.command = uint8_t(CommandType::MODIFY);
+            record.orderId = orderId;
+            record.price = newPrice;
+            record.quantity = newQuantity;
+            journalCommand(record);
+        }
+
+        OrderSide side = existing->side;
+        string clientId = cold(*existing).clientId;
+        submitCancel(orderId, false);
+        retireOrders(); // frees the old slot, so a full pool can still take the replacement
+        int newId = submitOrder(sideName(side), newPrice, newQuantity, LIMIT, clientId, 0.0, false);
+        if (newId < 0) {
+            OB_LOG_WARN("❌ Modify of order ID %d failed: order cancelled, replacement rejected", orderId);
+            return false;
+        }
+        OB_LOG_INFO("✅ Order Modified: ID %d -> New ID %d", orderId, newId);
+        return true;
+    }
+
+    bool submitCancel(int orderId, bool journaled) {
+        Order* found = findOrder(orderId);
+        if (journaled && found && (found->resting || (found->type == STOP && found->status == OPEN))) {
+            JournalRecord record{};
+            record.command = uint8_t(CommandType::CANCEL);
+            record.orderId = orderId;
+            journalCommand(record);
+        }
+        if (found && found->resting) {
+            Order& order = *found;
+            if (order.side == BUY) unlinkOrder(bids, order);
+            else unlinkOrder(asks, order);
+            updateOrderStatus(order, CANCELLED);
+            OB_LOG_INFO("✅ Order ID %d cancelled", orderId);
+            updateMarketData();
+            return true;
+        }
+        if (found && found->type == STOP && found->status == OPEN) {
+            if (found->side == BUY) disarmStop(buyStops, *found);
+            else disarmStop(sellStops, *found);
+            updateOrderStatus(*found, CANCELLED);
+            OB_LOG_INFO("✅ Stop Order ID %d cancelled", orderId);
+            return true;
+        }
+        OB_LOG_WARN("❌ Order ID %d not found", orderId);
+        return false;
+    }
+
+public:
+    double placeMarketOrder(string side, Lots quantity, uint32_t client) {
+        Lots remainingQty = quantity;
+        int64_t totalCost = 0; // sum of ticks * lots
+        Lots totalFilled = 0;
+
+        if (side == "buy") {
+            remainingQty = executeMarketOrder(asks, quantity, "buy", client, true, totalCost, totalFilled);
+        } else {
+            remainingQty = executeMarketOrder(bids, quantity, "sell", client, true, totalCost, totalFilled);
+        }
+
+        Order& order = *findOrder(orderCounter);
+        updateOrderStatus(order, remainingQty == quantity ? REJECTED : 
+                         (remainingQty > 0 ? PARTIAL : FILLED), quantity - remainingQty);
+        if (order.status == PARTIAL) retiring.push_back(order.handle); // the rest never rests
+        if (remainingQty > 0) OB_LOG_WARN("⚠️ Partial Fill: Remaining Qty %.6f", toQty(remainingQty));
+        afterMatching();
+
+        if (totalFilled > 0) {
+            return toPrice(1) * totalCost / totalFilled;
+        }
+        return 0.0;
+    }
+
+    // Crosses the book. The aggressor is the order just rested (or the stop
+    // just activated) and trades at the resting order's price. Timestamps
+    // cannot tell them apart: every order of a placeOrders burst shares its
+    // command time. Without an aggressor the later order ID takes.
+    void matchOrders(const Order* aggressor = nullptr) {
+        while (!bids.empty() && !asks.empty() && bids.bestPrice() >= asks.bestPrice()) {
+            PriceLevel& bidLevel = bids.best();
+            PriceLevel& askLevel = asks.best();
+
+            while (!bidLevel.orders.empty() && !askLevel.orders.empty()) {
+                Order& buyOrder = bidLevel.orders.front();
+                Order& sellOrder = askLevel.orders.front();
+                Lots tradeQty = min(buyOrder.quantity - buyOrder.filledQty, 
+                                    sellOrder.quantity - sellOrder.filledQty);
+                bool sellerIsMaker = aggressor ? &sellOrder != aggressor : sellOrder.id < buyOrder.id;
+                Ticks tradePrice = sellerIsMaker ? sellOrder.price : buyOrder.price;
+
+                Trade trade = {buyOrder.id, sellOrder.id, tradePrice, tradeQty, 
+                              commandTime, makerFee * notional(tradePrice, tradeQty)};
+                tradeHistory.push_back(toStored(trade));
+                noteTrade(trade.price);
+                bool buyerIsMaker = !sellerIsMaker; // the maker fee is charged to the maker
+                updatePosition(trade, buyOrder.client, sellOrder.client, buyerIsMaker);
+                publishTrade(trade);
+
+                OB_LOG_INFO("💰 MARKET TRADE: %.6f @ %.6f (Fee: %.2f)", toQty(tradeQty), toPrice(tradePrice), roundFee(trade.fee));
+
+                fillAtLevel(bids, bidLevel, buyOrder, tradeQty, tradePrice);
+                fillAtLevel(asks, askLevel, sellOrder, tradeQty, tradePrice);
+
+                updateOrderStatus(buyOrder, buyOrder.filledQty == buyOrder.quantity ? 
+                                FILLED : PARTIAL);
+                updateOrderStatus(sellOrder, sellOrder.filledQty == sellOrder.quantity ? 
+                                FILLED : PARTIAL);
+            }
+
+            if (bidLevel.orders.empty()) bids.erase(bids.bestPrice());
+            if (askLevel.orders.empty()) asks.erase(asks.bestPrice());
+        }
+        afterMatching();
+    }
+
+    template <typename Side>
+    Lots executeMarketOrder(Side& book, Lots quantity, 
+                           string side, uint32_t client, bool isTaker, int64_t& totalCost, Lots& totalFilled) {
+        Lots remainingQty = quantity;
+
+        while (!book.empty() && remainingQty > 0) {
+            Ticks price = book.bestPrice();
+            PriceLevel& level = book.best();
+            while (!level.orders.empty() && remainingQty > 0) {
+                Order& order = level.orders.front();
+                Lots tradeQty = min(remainingQty, order.quantity - order.filledQty);
+                double fee = (isTaker ? takerFee : makerFee) * notional(price, tradeQty);
+
+                Trade trade = {side == "buy" ? orderCounter : order.id,
+                              side == "buy" ? order.id : orderCounter,
+                              price, tradeQty, commandTime, 
+                              fee};
+                tradeHistory.push_back(toStored(trade));
+                bool buying = side == "buy";
+                noteTrade(trade.price);
+                updatePosition(trade, buying ? client : order.client, buying ? order.client : client,
+                               buying == isTaker);
+                publishTrade(trade);
+
+                OB_LOG_INFO("💰 MARKET TRADE: %.6f @ %.6f (Fee: %.2f)", toQty(tradeQty), toPrice(price), roundFee(fee));
+
+                totalCost += tradeQty * price;
+                totalFilled += tradeQty;
+
+                fillAtLevel(book, level, order, tradeQty, price);
+                remainingQty -= tradeQty;
+
+                updateOrderStatus(order, order.filledQty == order.quantity ? 
+                                FILLED : PARTIAL);
+            }
+            if (level.orders.empty()) book.erase(price);
+        }
+        return remainingQty;
+    }
+
+    void printOrderBook(int depth = 5) {
+        oblog::flush();
+        cout << fixed << setprecision(2);
+        cout << "\n===== ORDER BOOK =====\n";
+        cout << "Spread: " << getSpread() << " | Mid: " << getMidPrice() << endl;
+
+        cout << "Price(USDT)\tAmount(BTC)\tTotal(USDT)\n";
+        cout << "ASKS (Sell) [Red in UI]\n";
+        double askCumulativeTotal = 0.0;
+        int askCount = 0;
+        asks.forEach([&](Ticks price, const PriceLevel& level) {
+            if (askCount >= depth) return false;
+            Lots totalQty = level.openQty;
+            askCumulativeTotal += notional(price, totalQty);
+            cout << toPrice(price) << "\t\t" << fixed << setprecision(6) << toQty(totalQty) 
+                 << "\t\t" << formatTotal(askCumulativeTotal) << endl;
+            askCount++;
+            return true;
+        });
+
+        cout << "---------------------\n";
+
+        cout << "BIDS (Buy) [Green in UI]\n";
+        double bidCumulativeTotal = 0.0;
+        int bidCount = 0;
+        bids.forEach([&](Ticks price, const PriceLevel& level) {
+            if (bidCount >= depth) return false;
+            Lots totalQty = level.openQty;
+            bidCumulativeTotal += notional(price, totalQty);
+            cout << toPrice(price) << "\t\t" << fixed << setprecision(6) << toQty(totalQty) 
+                 << "\t\t" << formatTotal(bidCumulativeTotal) << endl;
+            bidCount++;
+            return true;
+        });
+        cout << "=====================\n";
+    }
+
+    void printDepthChart() {
+        oblog::flush();
+        cout << fixed << setprecision(2);
+        cout << "\n===== DEPTH CHART SIMULATION =====\n";
+
+        cout << "ASKS (Sell Orders Volume) [Red in UI]\n";
+        Lots askCumulativeVolume = 0;
+        asks.forEach([&](Ticks price, const PriceLevel& level) {
+            Lots totalQty = level.openQty;
+            askCumulativeVolume += totalQty;
+            cout << "Price: " << toPrice(price) << " | Volume: " << fixed << setprecision(6) << toQty(askCumulativeVolume) << endl;
+            return true;
+        });
+
+        cout << "---------------------\n";
+
+        cout << "BIDS (Buy Orders Volume) [Green in UI]\n";
+        Lots bidCumulativeVolume = 0;
+        bids.forEach([&](Ticks price, const PriceLevel& level) {
+            Lots totalQty = level.openQty;
+            bidCumulativeVolume += totalQty;
+            cout << "Price: " << toPrice(price) << " | Volume: " << fixed << setprecision(6) << toQty(bidCumulativeVolume) << endl;
+            return true;
+        });
+        cout << "=====================\n";
+    }
+
+    void detectSupportResistance(double threshold = 1.0) {
+        oblog::flush();
+        cout << "\n===== SUPPORT/RESISTANCE LEVELS =====\n";
+        Lots thresholdLots = llround(threshold / minQty);
+        bids.forEach([&](Ticks price, const PriceLevel& level) {
+            Lots totalQty = level.openQty;
+            if (totalQty >= thresholdLots) {
+                cout << "Support (Buy Wall) at Price: " << toPrice(price) << " | Qty: " << fixed << setprecision(6) << toQty(totalQty) << endl;
+            }
+            return true;
+        });
+        asks.forEach([&](Ticks price, const PriceLevel& level) {
+            Lots totalQty = level.openQty;
+            if (totalQty >= thresholdLots) {
+                cout << "Resistance (Sell Wall) at Price: " << toPrice(price) << " | Qty: " << fixed << setprecision(6) << toQty(totalQty) << endl;
+            }
+            return true;
+        });
+        cout << "=====================\n";
+    }
+
+    void printMatchedTrades() {
+        oblog::flush();
+        cout << "\n===== MATCHED TRADES =====\n";
+        forEachTrade([&](const Trade& trade) {
+            cout << "Timestamp: " << formatTimestamp(trade.timestamp) 
+                 << " | Price: " << toPrice(trade.price) 
+                 << " | Qty: " << fixed << setprecision(6) << toQty(trade.quantity) 
+                 << " | BuyID: " << trade.buyOrderId 
+                 << " | SellID: " << trade.sellOrderId 
+                 << " | Fee: " << fixed << setprecision(2) << roundFee(trade.fee) << endl;
+        });
+        cout << "========================\n";
+    }
+
+    // Any order this engine has seen. Live orders come from the pool;
+    // finished ones from the archive, which may mean scanning it and reading
+    // the archive file, so this is for reports, not the matching path.
+    bool findOrderRecord(int orderId, ArchivedOrder& out) {
+        if (const Order* live = findOrder(orderId)) {
+            out = toArchived(*live);
+            return true;
+        }
+        return archive.find(orderId, out);
+    }
+
+    void printOrderStatus(int orderId) {
+        oblog::flush();
+        ArchivedOrder order;
+        if (!findOrderRecord(orderId, order)) {
+            cout << "❌ Order ID " << orderId << " not found" << endl;
+            return;
+        }
+        OrderStatus status = OrderStatus(order.status);
+        cout << "\n===== ORDER STATUS =====\n";
+        cout << "ID: " << order.id << " | Side: " << sideName(OrderSide(order.side)) 
+             << " | Price: " << toPrice(order.price) << " | Qty: " << fixed << setprecision(6) << toQty(order.quantity) 
+             << " | Filled: " << fixed << setprecision(6) << toQty(order.filledQty) << " | Latency: " << order.latency << "ns";
+        if (order.type == STOP) cout << " | Stop Price: " << toPrice(order.stopPrice);
+        cout << endl;
+        cout << "Status: " << (status == OPEN ? "OPEN" : 
+                             status == PARTIAL ? "PARTIAL" : 
+                             status == FILLED ? "FILLED" : 
+                             status == CANCELLED ? "CANCELLED" : "REJECTED") << endl;
+        cout << "=====================\n";
+    }
+
+    void printClientPosition(string clientId) {
+        oblog::flush();
+        optional<PositionReport> pos = getPosition(clientId);
+        if (!pos) {
+            cout << "❌ Client " << clientId << " has no position" << endl;
+            return;
+        }
+        cout << "\n===== POSITION =====\n";
+        cout << "Client: " << clientId << " | Qty: " << fixed << setprecision(6) << pos->quantity 
+             << " | Avg Price: " << pos->avgPrice << endl;
+        cout << "Realized PnL: " << pos->realizedPnl << " | Unrealized PnL: " << pos->unrealizedPnl
+             << " | Fees: " << pos->feesPaid << " | Net Exposure: " << pos->netExposure
+             << " | Gross Exposure: " << pos->grossExposure << endl;
+        cout << "=====================\n";
+    }
+
+    void printPoolStats() {
+        oblog::flush();
+        auto print = [](const char* name, const PoolStats& stats) {
+            cout << name << " | Capacity: " << stats.capacity << " | In Use: " << stats.inUse
+                 << " | High Water: " << stats.highWater << " | Grows: " << stats.grows
+                 << " | Rejects: " << stats.rejects << " | Overwrites: " << stats.overwrites << endl;
+        };
+        cout << "\n===== POOL STATS =====\n";
+        print("Orders", orderPool.getStats());
+        print("Trades", tradeHistory.getStats());
+        const OrderArchiveStats& archived = archive.getStats();
+        cout << "Orders archived: " << archived.archived << " | In Memory: " << archived.inMemory
+             << " | Spilled: " << archived.spilled << endl;
+        cout << "Log records dropped: " << oblog::dropped() << endl;
+        cout << "=====================\n";
+    }
+
+    void printLatencyStats() {
+        oblog::flush();
+        cout << "\n===== LATENCY (ns) =====\n";
+        latency.print(cout);
+        cout << "=====================\n";
+    }
+
+    // Copies the full engine state (resting orders in priority order, pending
+    // stops, positions, counters, fees and tick sizes) into a binary image.
+    void captureSnapshot(vector<unsigned char>& out) { captureSnapshot(out, journal ? journal->lastSeq() : 0); }
+
+    // journalSeq: the last journaled command the state includes.
+    void captureSnapshot(vector<unsigned char>& out, uint64_t journalSeq) {
+        SnapshotBuilder& image = snapshotImage;
+        image.clear();
+        auto record = [&](const Order& order) {
+            const OrderCold& details = cold(order);
+            SnapshotOrder s{order.price, order.quantity, order.filledQty, details.stopPrice, toNanos(order.timestamp),
+                            details.latency.count(), 0, 0, order.id, uint8_t(order.side),
+                            uint8_t(order.type), uint8_t(order.status), 0};
+            image.intern(details.clientId, s.clientOffset, s.clientLength);
+            return s;
+        };
+        bids.forEach([&](Ticks, const PriceLevel& level) {
+            for (const Order& order : level.orders) image.addBid(record(order));
+            return true;
+        });
+        asks.forEach([&](Ticks, const PriceLevel& level) {
+            for (const Order& order : level.orders) image.addAsk(record(order));
+            return true;
+        });
+        auto stops = [&](Ticks, const OrderQueue& level) {
+            for (const Order& order : level) image.addStop(record(order));
+            return true;
+        };
+        buyStops.forEach(stops);
+        sellStops.forEach(stops);
+        for (uint32_t client = 1; client < positions.size(); ++client) {
+            const Position& pos = positions[client];
+            if (!pos.fills) continue;
+            SnapshotPosition p{0, 0, pos.quantity, pos.avgPrice, pos.realizedPnl, pos.feesPaid, pos.fills};
+            image.intern(clientNames[client], p.clientOffset, p.clientLength);
+            image.addPosition(p);
+        }
+
+        SnapshotHeader& header = image.header;
+        header.journalSeq = journalSeq;
+        header.takenAt = toNanos(chrono::system_clock::now());
+        header.minPrice = minPrice;
+        header.minQty = minQty;
+        header.makerFee = makerFee;
+        header.takerFee = takerFee;
+        header.orderCounter = orderCounter;
+        image.finish(out);
+    }
+
+    bool saveSnapshot(const string& filename) {
+        vector<unsigned char> image;
+        captureSnapshot(image);
+        if (!writeSnapshotFile(filename, image)) {
+            OB_LOG_ERROR("❌ Failed to save snapshot");
+            return false;
+        }
+        OB_LOG_INFO("✅ Snapshot saved to %s", filename);
+        return true;
+    }
+
+    // Snapshot of the current state through the attached SnapshotWriter: the
+    // matching thread only queues the request, and the writer's mirror
+    // captures and writes it once it has applied every command before it.
+    // Returns the journal sequence the snapshot covers, or nullopt when no
+    // writer is attached or the previous snapshot is still pending.
+    optional<uint64_t> saveSnapshotAsync(const string& filename) {
+        if (!snapshotWriter) {
+            OB_LOG_WARN("⚠️ Snapshot skipped: no snapshot writer attached");
+            return nullopt;
+        }
+        uint64_t seq = journal ? journal->lastSeq() : 0;
+        if (!snapshotWriter->requestSnapshot(filename, seq)) {
+            OB_LOG_WARN("⚠️ Snapshot skipped: previous snapshot still being written");
+            return nullopt;
+        }
+        return seq;
+    }
+
+    // Replaces the engine state with the snapshot's. Orders keep their original
+    // timestamps, so time priority survives the reload. journalSeq receives the
+    // last journaled command the snapshot includes; replay from there.
+    bool loadSnapshot(const string& filename, uint64_t* journalSeq = nullptr) {
+        SnapshotView view(filename);
+        if (!view.valid()) {
+            OB_LOG_ERROR("❌ Failed to load snapshot %s: missing, incompatible or corrupt", filename);
+            return false;
+        }
+        if (!restoreSnapshot(view)) return false;
+        if (journalSeq) *journalSeq = view.header->journalSeq;
+        OB_LOG_INFO("✅ Snapshot loaded from %s", filename);
+        return true;
+    }
+
+    // Same from an image captureSnapshot produced (how a SnapshotWriter's
+    // mirror takes on the live book's state).
+    bool loadSnapshotImage(const vector<unsigned char>& image) {
+        SnapshotView view(image);
+        return view.valid() && restoreSnapshot(view);
+    }
+
+private:
+    bool restoreSnapshot(const SnapshotView& view) {
+        const SnapshotHeader& header = *view.header;
+
+        // The snapshot replaces the book's whole history: finished orders
+        // waiting to retire are dropped with the rest, and archived records
+        // (whose client indexes are about to be reassigned) are forgotten.
+        bids.clear();
+        asks.clear();
+        buyStops.clear();
+        sellStops.clear();
+        releaseAllOrders();
+        archive.clear();
+        clientIndex.clear();
+        clientNames.assign(1, string());
+        positions.assign(1, Position{});
+        if (marketData) marketData->publish(toNanos(commandTime), 0, LevelAction::CLEAR, 0, 0, 0);
+        if (orderFeed) orderFeed->publish(toNanos(commandTime), OrderEventType::CLEAR, 0, 0, 0, 0);
+        minPrice = header.minPrice;
+        minQty = header.minQty;
+        makerFee = header.makerFee;
+        takerFee = header.takerFee;
+        orderCounter = int(header.orderCounter);
+
+        auto restore = [&](const SnapshotOrder& s) -> Order* {
+            uint32_t handle = allocateOrder(Order{s.id, OrderSide(s.side), OrderType(s.type), OrderStatus(s.status), false,
+                                                  s.price, s.quantity, s.filledQty, fromNanos(s.timestamp)},
+                                            OrderCold{string(view.string(s.clientOffset, s.clientLength)), s.stopPrice,
+                                                      chrono::nanoseconds(s.latency)});
+            if (handle == SlabPool<Order>::INVALID) return nullptr;
+            Order& tracked = orderPool[handle];
+            tracked.client = internClient(orderCold[handle].clientId);
+            orderIndex.insert(s.id, handle);
+            return &tracked;
+        };
+
+        bool complete = true;
+        for (uint64_t i = 0; complete && i < header.bidOrders + header.askOrders; ++i) {
+            Order* order = restore(view.bids[i]); // asks follow bids in the file
+            if (order) restOrder(*order);
+            else complete = false;
+        }
+        for (uint64_t i = 0; complete && i < header.stopOrders; ++i) {
+            Order* order = restore(view.stops[i]);
+            if (order) armStop(*order);
+            else complete = false;
+        }
+        for (uint64_t i = 0; i < header.positions; ++i) {
+            const SnapshotPosition& p = view.positions[i];
+            uint32_t client = internClient(string(view.string(p.clientOffset, p.clientLength)));
+            if (client) positions[client] = Position{p.quantity, p.avgPrice, p.realizedPnl, p.feesPaid, p.fills};
+        }
+        updateMarketData();
+        if (snapshotWriter) seedSnapshotWriter();
+
+        if (!complete) {
+            OB_LOG_ERROR("❌ Snapshot truncated: order pool exhausted");
+            return false;
+        }
+        return true;
+    }
+
+    void seedSnapshotWriter() {
+        vector<unsigned char> image;
+        captureSnapshot(image);
+        snapshotWriter->seed(image);
+    }
+
+public:
+
+    // Safe from any thread while the book is running: the touch as of the end
+    // of the last command that changed it. Prices are in ticks and sizes in
+    // lots (toPrice / toQty convert; the grid cannot change while orders rest).
+    TopOfBook readTopOfBook() const { return topOfBook.load(); }
+
+    // Single attempt that never spins; false if the touch was being updated.
+    bool tryReadTopOfBook(TopOfBook& out) const { return topOfBook.tryLoad(out); }
+
+    optional<double> getBestBid() const { return bestBid ? optional<double>{toPrice(*bestBid)} : nullopt; }
+    optional<double> getBestAsk() const { return bestAsk ? optional<double>{toPrice(*bestAsk)} : nullopt; }
+    double getMidPrice() const { 
+        if (bestBid && bestAsk) return toPrice(*bestBid + *bestAsk) / 2.0; 
+        return bestBid ? toPrice(*bestBid) : bestAsk ? toPrice(*bestAsk) : 0.0;
+    }
+    double getSpread() const { 
+        if (bestBid && bestAsk) return toPrice(*bestAsk - *bestBid); 
+        return 0.0;
+    }
+    // Copies up to maxLevels levels of one side, best first, into out. Reads the
+    // level aggregates only, so the cost is the number of levels returned.
+    size_t getDepth(const string& side, DepthLevel* out, size_t maxLevels) {
+        size_t n = 0;
+        auto copy = [&](Ticks price, const PriceLevel& level) {
+            if (n == maxLevels) return false;
+            out[n++] = {price, level.openQty, level.orderCount, notional(price, level.openQty)};
+            return true;
+        };
+        if (side == "buy") bids.forEach(copy);
+        else asks.forEach(copy);
+        return n;
+    }
+
+    // Client ID, stop price and latency of an order the engine holds, e.g. one
+    // passed to a sink's onOrder.
+    const OrderCold& orderDetails(const Order& order) const { return orderCold[order.handle]; }
+
+    // Visits the resting orders of one side in priority order (best level
+    // first, FIFO within it) as f(id, price, openQty) -> keep going?
+    template <typename F>
+    void forEachRestingOrder(const string& side, F&& f) {
+        auto visit = [&](Ticks price, const PriceLevel& level) {
+            for (const Order& order : level.orders) {
+                if (!f(order.id, price, order.quantity - order.filledQty)) return false;
+            }
+            return true;
+        };
+        if (side == "buy") bids.forEach(visit);
+        else asks.forEach(visit);
+    }
+
+    // Quantity an order on `side` could take at limitPrice or better.
+    double getLiquidity(const string& side, double limitPrice) const {
+        double ticks = limitPrice / minPrice;
+        Ticks limit = side == "buy" ? Ticks(floor(ticks + EPSILON)) : Ticks(ceil(ticks - EPSILON));
+        return toQty(side == "buy" ? asks.depthUpTo(limit) : bids.depthUpTo(limit));
+    }
+
+    // Walks the opposite side for `quantity` without touching it: average and
+    // worst fill price and the cost of the sweep, in O(log levels).
+    ImpactEstimate estimateImpact(const string& side, double quantity) const {
+        SweepResult sweep = side == "buy" ? asks.sweep(Lots(llround(quantity / minQty)))
+                                          : bids.sweep(Lots(llround(quantity / minQty)));
+        if (sweep.filled == 0) return {0.0, 0.0, 0.0, 0.0};
+        double cost = toPrice(1) * toQty(1) * double(sweep.cost);
+        return {toQty(sweep.filled), toPrice(1) * double(sweep.cost) / double(sweep.filled),
+                toPrice(sweep.lastPrice), cost};
+    }
+
+    // nullopt for a client with no fills.
+    optional<PositionReport> getPosition(const string& clientId) const {
+        auto it = clientIndex.find(clientId);
+        if (it == clientIndex.end() || !positions[it->second].fills) return nullopt;
+        const Position& pos = positions[it->second];
+        double mark = markPrice > 0 ? markPrice : double(lastTradePrice);
+        double value = toPrice(1) * toQty(1); // of one tick x lot
+        double exposure = value * mark * double(pos.quantity);
+        return PositionReport{toQty(pos.quantity), toPrice(1) * pos.avgPrice, value * pos.realizedPnl,
+                              value * (mark - pos.avgPrice) * double(pos.quantity), pos.feesPaid, exposure,
+                              fabs(exposure), pos.fills};
+    }
+
+    const PoolStats& getOrderPoolStats() const { return orderPool.getStats(); }
+    const OrderArchiveStats& getArchiveStats() const { return archive.getStats(); }
+    size_t liveOrderCount() const { return orderIndex.size(); }
+    size_t orderIndexBytes() const { return orderIndex.memoryBytes(); }
+    // Safe to query from any thread while this one keeps matching.
+    const LatencyRecorder& getLatencyStats() const { return latency; }
+    const PoolStats& getTradePoolStats() const { return tradeHistory.getStats(); }
+    const TradeStoreStats& getTradeStoreStats() const { return tradeHistory.getStoreStats(); }
+
+    // Trade history queries, oldest first, reading spilled trades back from
+    // disk where their chunks can match. f(const Trade&).
+    template <typename F>
+    void forEachTrade(F&& f) {
+        tradeHistory.forEach([&](const StoredTrade& t) { f(fromStored(t)); });
+    }
+
+    // Trades with from <= timestamp < to.
+    template <typename F>
+    void forEachTrade(chrono::system_clock::time_point from, chrono::system_clock::time_point to, F&& f) {
+        tradeHistory.forEachInTimeRange(toNanos(from), toNanos(to), [&](const StoredTrade& t) { f(fromStored(t)); });
+    }
+
+    // Trades the order took part in, on either side.
+    template <typename F>
+    void forEachTradeOfOrder(int orderId, F&& f) {
+        tradeHistory.forEachForOrder(orderId, [&](const StoredTrade& t) { f(fromStored(t)); });
+    }
+    void setFees(double maker, double taker) {
+        beginCommand();
+        JournalRecord record{};
+        record.command = uint8_t(CommandType::SET_FEES);
+        record.price = maker;
+        record.quantity = taker;
+        journalCommand(record);
+        makerFee = maker;
+        takerFee = taker;
+    }
+
+    // Defines the integer grid every price and quantity is stored on, so it can
+    // only change while the book holds no orders.
+    bool setTickSize(double price, double qty) {
+        if (!orderIndex.empty() || !archive.empty() || price <= 0 || qty <= 0) {
+            OB_LOG_WARN("❌ Tick size can only be set on an empty book");
+            return false;
+        }
+        beginCommand();
+        JournalRecord record{};
+        record.command = uint8_t(CommandType::SET_TICK_SIZE);
+        record.price = price;
+        record.quantity = qty;
+        journalCommand(record);
+        minPrice = price;
+        minQty = qty;
+        return true;
+    }
+
+    // Records every accepted command from now on; nullptr detaches. The journal
+    // must outlive the book or be detached first.
+    void attachJournal(CommandJournal* j) { journal = j; }
+
+    // The book a SnapshotWriter runs as its mirror: this one without the sink.
+    using Mirror = BasicOrderBook<Backend, NullSink>;
+
+    // Pools for the mirror of a book built with `pools`: the same order pool,
+    // no files of its own, and only a token trade and order history, which
+    // snapshots do not include.
+    static PoolConfig mirrorPools(PoolConfig pools) {
+        pools.orderOverflow = OverflowPolicy::GROW;
+        pools.tradeCapacity = 4096;
+        pools.tradeOverflow = OverflowPolicy::OVERWRITE;
+        pools.tradeSpillDir.clear();
+        pools.archiveCapacity = 4096;
+        pools.orderArchiveFile.clear();
+        pools.archiveOverflow = OverflowPolicy::OVERWRITE;
+        return pools;
+    }
+
+    // Mirrors every accepted command into the writer from now on, after
+    // starting its mirror from a capture of the current state (the one time
+    // attaching copies the book); nullptr detaches. The writer must outlive
+    // the book or be detached first.
+    void attachSnapshotWriter(SnapshotWriter<Mirror>* writer) {
+        snapshotWriter = writer;
+        if (writer) seedSnapshotWriter();
+    }
+
+    // Hands journal records that have waited syncInterval to the journal's
+    // flusher. Appends only check that as the next record arrives, so whoever
+    // drives the book calls this while idle (Sequencer does on every empty
+    // poll). It does not wait for the disk; see CommandJournal::durableSeq.
+    void flushJournalIfDue() {
+        if (journal) journal->flushIfDue(toNanos(chrono::system_clock::now()));
+    }
+
+    // Streams L2 level updates from now on; nullptr detaches. Attach to an
+    // empty book (or load a snapshot after attaching) so the consumer's view
+    // starts complete. The publisher must outlive the book or be detached first.
+    void attachMarketData(MarketDataPublisher* publisher) { marketData = publisher; }
+
+    // Same for the L3 order-by-order feed.
+    void attachOrderFeed(OrderFeedPublisher* publisher) { orderFeed = publisher; }
+
+    // Feeds every trade to the analytics and publishes its snapshot after each
+    // command; nullptr detaches. Readers use the analytics object directly.
+    void attachAnalytics(TradeAnalytics* a) { analytics = a; }
+
+    // Re-runs one journaled command at its original time. Applied in sequence to
+    // a book in the state the journal started from, the records reproduce every
+    // order ID, fill, fee and position.
+    void applyCommand(const JournalRecord& record) {
+        if (snapshotWriter) snapshotWriter->mirrorCommand(record);
+        CommandType type = CommandType(record.command);
+        bool timed = type == CommandType::PLACE || type == CommandType::CANCEL || type == CommandType::MODIFY;
+        if (timed) beginTimedCommand(fromNanos(record.timestamp));
+        else beginCommand(fromNanos(record.timestamp));
+        switch (type) {
+            case CommandType::PLACE:
+                submitOrder(record.side == 0 ? "buy" : "sell", record.price, record.quantity,
+                            OrderType(record.orderType), record.clientId, record.stopPrice, false);
+                break;
+            case CommandType::CANCEL: submitCancel(record.orderId, false); break;
+            case CommandType::MODIFY: submitModify(record.orderId, record.price, record.quantity, false); break;
+            case CommandType::SET_FEES:
+                makerFee = record.price;
+                takerFee = record.quantity;
+                break;
+            case CommandType::SET_TICK_SIZE:
+                minPrice = record.price;
+                minQty = record.quantity;
+                break;
+            case CommandType::BATCH_BEGIN: beginBatch(false); break;
+            case CommandType::BATCH_END: endBatch(false); break;
+        }
+        if (timed) endCommand();
+    }
+
+    // Applies the records of a journal file after afterSeq (e.g. the sequence a
+    // snapshot was taken at). Returns the number of commands applied.
+    uint64_t replayJournal(const string& path, uint64_t afterSeq = 0) {
+        JournalReader reader(path);
+        if (!reader.isOpen()) {
+            OB_LOG_ERROR("❌ Cannot read journal %s", path);
+            return 0;
+        }
+        uint64_t applied = 0;
+        reader.forEach([&](const JournalRecord& record) {
+            if (record.seq <= afterSeq) return;
+            applyCommand(record);
+            applied++;
+        });
+        OB_LOG_INFO("✅ Replayed %llu commands from %s", (unsigned long long)applied, path);
+        return applied;
+    }
+
+    double toPrice(Ticks ticks) const { return ticks * minPrice; }
+    double toQty(Lots lots) const { return lots * minQty; }
+    double notional(Ticks price, Lots qty) const { return toPrice(price) * toQty(qty); }
+
+    Sink& getSink() { return sink; }
+};
+
+using OrderBook = BasicOrderBook<>;
+
+#endif
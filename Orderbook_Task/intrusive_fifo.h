@@ -0,0 +1,72 @@
+#ifndef INTRUSIVE_FIFO_H
+#define INTRUSIVE_FIFO_H
+
+// Doubly linked FIFO threaded through the nodes themselves (Node must have
+// `Node* prev` and `Node* next`). A price level is just head/tail pointers, so
+// append, pop and unlinking any node by pointer are O(1) with no allocation.
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+template <typename Node>
+class IntrusiveFifo {
+private:
+    Node* head = nullptr;
+    Node* tail = nullptr;
+
+public:
+    class iterator {
+        Node* node;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Node;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Node*;
+        using reference = Node&;
+
+        explicit iterator(Node* n = nullptr) : node(n) {}
+        Node& operator*() const { return *node; }
+        Node* operator->() const { return node; }
+        iterator& operator++() { node = node->next; return *this; }
+        bool operator==(const iterator& other) const { return node == other.node; }
+        bool operator!=(const iterator& other) const { return node != other.node; }
+    };
+
+    IntrusiveFifo() = default;
+    IntrusiveFifo(const IntrusiveFifo&) = delete;
+    IntrusiveFifo& operator=(const IntrusiveFifo&) = delete;
+    IntrusiveFifo(IntrusiveFifo&& other) noexcept
+        : head(std::exchange(other.head, nullptr)), tail(std::exchange(other.tail, nullptr)) {}
+    IntrusiveFifo& operator=(IntrusiveFifo&& other) noexcept {
+        head = std::exchange(other.head, nullptr);
+        tail = std::exchange(other.tail, nullptr);
+        return *this;
+    }
+
+    bool empty() const { return head == nullptr; }
+    Node& front() const { return *head; }
+
+    void push_back(Node* node) {
+        node->prev = tail;
+        node->next = nullptr;
+        (tail ? tail->next : head) = node;
+        tail = node;
+    }
+
+    void erase(Node* node) {
+        (node->prev ? node->prev->next : head) = node->next;
+        (node->next ? node->next->prev : tail) = node->prev;
+        node->prev = node->next = nullptr;
+    }
+
+    void pop_front() { erase(head); }
+
+    // Forgets the nodes without touching them; only for levels being discarded.
+    void clear() { head = tail = nullptr; }
+
+    iterator begin() const { return iterator(head); }
+    iterator end() const { return iterator(); }
+};
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef L3_BOOK_BUILDER_H
+#define L3_BOOK_BUILDER_H
+
+// Client-side book rebuilt from the L3 order feed (OrderEvent, see
+// market_data.h). Orders sit in FIFO queues per price level exactly as they do
+// in the engine, so a consumer can ask where an order is in its queue.
+//
+// Nothing is allocated per event: order nodes come from a preallocated
+// SlabPool, the ID index is an open-addressed table sized for orderCapacity
+// and levels live in a PriceLadder window. Going past those sizes grows them
+// (counted in getStats()) rather than failing.
+//
+// Independent of the engine: it only needs the event stream. checkL3Book()
+// at the bottom compares a builder with a live engine.
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "intrusive_fifo.h"
+#include "market_data.h"
+#include "object_pool.h"
+#include "price_ladder.h"
+
+struct L3BuilderConfig {
+    size_t orderCapacity = 1 << 16; // resting orders before the pool and index grow
+    size_t priceLevels = 4096;      // initial ladder window per side
+};
+
+struct L3BuilderStats {
+    uint64_t applied = 0;
+    uint64_t gaps = 0;        // seq jumps: events were lost, resync from a snapshot
+    uint64_t rejected = 0;    // events that do not fit the book (unknown ID, duplicate add, overfill)
+    uint64_t indexGrows = 0;
+};
+
+class L3BookBuilder {
+public:
+    struct BookOrder {
+        int32_t id;
+        uint8_t side; // 0 = buy, 1 = sell
+        int64_t price;
+        int64_t openQty;
+        int64_t timestamp; // of the ADD
+        uint32_t handle = 0;
+        BookOrder* prev = nullptr;
+        BookOrder* next = nullptr;
+    };
+
+    struct BookLevel {
+        IntrusiveFifo<BookOrder> orders;
+        int64_t openQty = 0;
+        uint32_t orderCount = 0;
+
+        void clear() {
+            orders.clear();
+            openQty = 0;
+            orderCount = 0;
+        }
+    };
+
+private:
+    // Order ID -> pool handle. Linear probing with backward-shift deletion, so
+    // there are no tombstones; ID 0 marks an empty slot (the engine starts at 1).
+    struct IndexEntry {
+        int32_t id = 0;
+        uint32_t handle = 0;
+    };
+
+    SlabPool<BookOrder> orders;
+    std::vector<IndexEntry> index;
+    size_t indexed = 0;
+    PriceLadder<BookLevel, true> bids;
+    PriceLadder<BookLevel, false> asks;
+    uint64_t lastSeq = 0;
+    L3BuilderStats stats;
+
+    size_t home(int32_t id) const { return (uint32_t(id) * 2654435761u) & (index.size() - 1); }
+
+    size_t slotOf(int32_t id) const {
+        size_t i = home(id);
+        while (index[i].id != 0 && index[i].id != id) i = (i + 1) & (index.size() - 1);
+        return i;
+    }
+
+    void growIndex() {
+        std::vector<IndexEntry> previous = std::move(index);
+        index.assign(previous.size() * 2, IndexEntry{});
+        for (const IndexEntry& e : previous) {
+            if (e.id != 0) index[slotOf(e.id)] = e;
+        }
+        stats.indexGrows++;
+    }
+
+    void unindex(int32_t id) {
+        size_t mask = index.size() - 1;
+        size_t hole = slotOf(id);
+        for (size_t j = (hole + 1) & mask; index[j].id != 0; j = (j + 1) & mask) {
+            size_t k = home(index[j].id);
+            bool stays = hole <= j ? (hole < k && k <= j) : (hole < k || k <= j);
+            if (stays) continue;
+            index[hole] = index[j];
+            hole = j;
+        }
+        index[hole] = IndexEntry{};
+        indexed--;
+    }
+
+    BookOrder* lookup(int32_t id) {
+        const IndexEntry& e = index[slotOf(id)];
+        return e.id == id ? &orders[e.handle] : nullptr;
+    }
+
+    bool reject() {
+        stats.rejected++;
+        return false;
+    }
+
+    template <typename Side>
+    void add(Side& side, BookOrder& order) {
+        BookLevel& level = side[order.price];
+        level.orders.push_back(&order);
+        level.openQty += order.openQty;
+        level.orderCount++;
+        side.addDepth(order.price, order.openQty);
+    }
+
+    // Takes qty off an order; it leaves the book once nothing is open.
+    template <typename Side>
+    void reduce(Side& side, BookOrder& order, int64_t qty) {
+        BookLevel& level = *side.find(order.price);
+        level.openQty -= qty;
+        order.openQty -= qty;
+        side.addDepth(order.price, -qty);
+        if (order.openQty > 0) return;
+        level.orders.erase(&order);
+        level.orderCount--;
+        if (level.orders.empty()) side.erase(order.price);
+        unindex(order.id);
+        orders.release(order.handle);
+    }
+
+public:
+    explicit L3BookBuilder(const L3BuilderConfig& config = {})
+        : orders(config.orderCapacity, OverflowPolicy::GROW),
+          index(std::bit_ceil(std::max<size_t>(config.orderCapacity * 2, 16))),
+          bids(config.priceLevels),
+          asks(config.priceLevels) {}
+
+    ~L3BookBuilder() { clear(); }
+
+    L3BookBuilder(const L3BookBuilder&) = delete;
+    L3BookBuilder& operator=(const L3BookBuilder&) = delete;
+
+    // Applies one event. Returns false, and leaves the book as it was, if the
+    // event does not fit it; a gap in seq is counted but still applied.
+    bool apply(const OrderEvent& event) {
+        if (lastSeq != 0 && event.seq != lastSeq + 1) stats.gaps++;
+        lastSeq = event.seq;
+
+        if (event.type == OrderEventType::CLEAR) {
+            clear();
+        } else if (event.type == OrderEventType::ADD) {
+            if (event.orderId == 0 || event.quantity <= 0 || event.side > 1 || lookup(event.orderId)) return reject();
+            if ((indexed + 1) * 2 > index.size()) growIndex();
+            uint32_t handle = orders.allocate(BookOrder{event.orderId, event.side, event.price, event.quantity,
+                                                        event.timestamp});
+            if (handle == SlabPool<BookOrder>::INVALID) return reject();
+            BookOrder& order = orders[handle];
+            order.handle = handle;
+            index[slotOf(event.orderId)] = IndexEntry{event.orderId, handle};
+            indexed++;
+            if (order.side == 0) add(bids, order);
+            else add(asks, order);
+        } else {
+            BookOrder* order = lookup(event.orderId);
+            if (!order) return reject();
+            int64_t qty = event.type == OrderEventType::DELETE ? order->openQty : event.quantity;
+            if (qty <= 0 || qty > order->openQty) return reject();
+            if (order->side == 0) reduce(bids, *order, qty);
+            else reduce(asks, *order, qty);
+        }
+        stats.applied++;
+        return true;
+    }
+
+    void clear() {
+        for (IndexEntry& e : index) {
+            if (e.id != 0) orders.release(e.handle);
+            e = IndexEntry{};
+        }
+        indexed = 0;
+        bids.clear();
+        asks.clear();
+    }
+
+    const BookOrder* findOrder(int32_t id) { return lookup(id); }
+
+    // Open quantity queued ahead of the order at its level, or -1 if unknown.
+    int64_t queueAhead(int32_t id) {
+        const BookOrder* order = lookup(id);
+        if (!order) return -1;
+        int64_t ahead = 0;
+        for (const BookOrder* o = order->prev; o; o = o->prev) ahead += o->openQty;
+        return ahead;
+    }
+
+    bool hasBids() const { return !bids.empty(); }
+    bool hasAsks() const { return !asks.empty(); }
+    int64_t bestBid() const { return bids.bestPrice(); } // ticks; only when hasBids()
+    int64_t bestAsk() const { return asks.bestPrice(); }
+
+    // Levels best first as f(price, openQty, orderCount) -> keep going?
+    template <typename F>
+    void forEachLevel(uint8_t side, F&& f) {
+        auto visit = [&](int64_t price, const BookLevel& level) { return f(price, level.openQty, level.orderCount); };
+        if (side == 0) bids.forEach(visit);
+        else asks.forEach(visit);
+    }
+
+    // Orders in priority order as f(id, price, openQty) -> keep going?
+    template <typename F>
+    void forEachOrder(uint8_t side, F&& f) {
+        auto visit = [&](int64_t price, const BookLevel& level) {
+            for (const BookOrder& order : level.orders) {
+                if (!f(order.id, price, order.openQty)) return false;
+            }
+            return true;
+        };
+        if (side == 0) bids.forEach(visit);
+        else asks.forEach(visit);
+    }
+
+    size_t orderCount() const { return indexed; }
+    uint64_t lastSequence() const { return lastSeq; }
+    const L3BuilderStats& getStats() const { return stats; }
+};
+
+struct L3CheckResult {
+    bool consistent = true;
+    size_t ordersChecked = 0;
+    std::string mismatch; // first difference found
+};
+
+// Compares a builder, order by order and in queue order, with the engine it
+// was fed from. Call it while the engine is quiet and the feed drained; it
+// allocates and walks both books, so it is a test and audit tool, not a hot
+// path. Book needs forEachRestingOrder(side, f(id, price, openQty)).
+template <typename Book>
+L3CheckResult checkL3Book(L3BookBuilder& builder, Book& book) {
+    struct Entry {
+        int32_t id;
+        int64_t price;
+        int64_t openQty;
+    };
+    L3CheckResult result;
+    std::vector<Entry> expected, actual;
+    for (uint8_t side = 0; side < 2 && result.consistent; ++side) {
+        expected.clear();
+        actual.clear();
+        book.forEachRestingOrder(side == 0 ? "buy" : "sell", [&](int id, int64_t price, int64_t open) {
+            expected.push_back({int32_t(id), price, open});
+            return true;
+        });
+        builder.forEachOrder(side, [&](int32_t id, int64_t price, int64_t open) {
+            actual.push_back({id, price, open});
+            return true;
+        });
+        for (size_t i = 0; i < std::max(expected.size(), actual.size()); ++i) {
+            const char* name = side == 0 ? "bid" : "ask";
+            if (i >= expected.size() || i >= actual.size()) {
+                result.consistent = false;
+                result.mismatch = std::string(name) + " order count: engine " + std::to_string(expected.size()) +
+                                  ", builder " + std::to_string(actual.size());
+                break;
+            }
+            const Entry& e = expected[i];
+            const Entry& a = actual[i];
+            if (e.id != a.id || e.price != a.price || e.openQty != a.openQty) {
+                result.consistent = false;
+                result.mismatch = std::string(name) + " queue position " + std::to_string(i) + ": engine order " +
+                                  std::to_string(e.id) + " @" + std::to_string(e.price) + " x" +
+                                  std::to_string(e.openQty) + ", builder order " + std::to_string(a.id) + " @" +
+                                  std::to_string(a.price) + " x" + std::to_string(a.openQty);
+                break;
+            }
+            result.ordersChecked++;
+        }
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,268 @@
+#ifndef LATENCY_STATS_H
+#define LATENCY_STATS_H
+
+// Measured per-stage latency of the engine's commands. The matching thread
+// stamps each command as it is received, validated, matched and published
+// (its events delivered to the sink and feeds), and adds the stage times to
+// HDR-style histograms that any thread can query or dump while it runs.
+//
+// TscClock reads the CPU timestamp counter: a few ns, no syscall. It is
+// calibrated against steady_clock once per process and assumes an invariant
+// TSC (constant_tsc and nonstop_tsc in /proc/cpuinfo), as on any recent x86
+// server. Elsewhere it falls back to steady_clock.
+//
+// LatencyHistogram keeps values below 128 ns exactly and splits every power
+// of two above into 64 buckets, so a percentile is off by at most 1/64 of
+// its value (it reports the top of its bucket). It has one writer, which
+// updates relaxed atomics with plain loads and stores: no lock and no
+// read-modify-write. Readers on other threads may see the latest few
+// records only in part.
+//
+// Stamping costs the engine up to four timestamp reads and a few histogram
+// updates per order command. Build with -DOB_LATENCY_STATS=0 to compile the
+// stamps out; the histograms then stay empty and orders report 0 ns.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef OB_LATENCY_STATS
+#define OB_LATENCY_STATS 1
+#endif
+
+class TscClock {
+public:
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch())
+                            .count());
+#endif
+    }
+
+    // Ticks per ns, measured by spinning for `span` against steady_clock.
+    static double calibrate(std::chrono::nanoseconds span = std::chrono::milliseconds(10)) {
+#if defined(__x86_64__) || defined(__i386__)
+        auto start = std::chrono::steady_clock::now();
+        uint64_t startTicks = now();
+        auto end = start;
+        while (end - start < span) end = std::chrono::steady_clock::now();
+        uint64_t endTicks = now();
+        return double(endTicks - startTicks) /
+               double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+#else
+        (void)span;
+        return 1.0;
+#endif
+    }
+
+    // Process-wide, calibrated on first use.
+    static double nsPerTick() {
+        static const double ns = 1.0 / calibrate();
+        return ns;
+    }
+};
+
+struct LatencySummary {
+    uint64_t count;
+    double mean; // ns
+    int64_t p50;
+    int64_t p99;
+    int64_t p999;
+    int64_t max;
+};
+
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BITS = 6;
+    static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BITS; // per power of two
+    static constexpr unsigned MAX_BITS = 40;
+    static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_BITS) - 1; // ~18 minutes; larger values clamp
+    static constexpr size_t BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_BUCKETS;
+
+private:
+    std::vector<std::atomic<uint64_t>> counts = std::vector<std::atomic<uint64_t>>(BUCKETS);
+    std::atomic<uint64_t> total{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> maxValue{0};
+
+    static void bump(std::atomic<uint64_t>& a, uint64_t by) {
+        a.store(a.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    // Values below 2 * SUB_BUCKETS index themselves; above, a bucket is the
+    // top SUB_BITS + 1 bits of the value.
+    static size_t indexOf(uint64_t v) {
+        if (v < 2 * SUB_BUCKETS) return size_t(v);
+        unsigned shift = unsigned(63 - __builtin_clzll(v)) - SUB_BITS;
+        return size_t((shift + 1) * SUB_BUCKETS + ((v >> shift) - SUB_BUCKETS));
+    }
+
+    static uint64_t highestIn(size_t index) {
+        if (index < 2 * SUB_BUCKETS) return index;
+        unsigned shift = unsigned(index / SUB_BUCKETS) - 1;
+        uint64_t low = (index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+        return low + (uint64_t(1) << shift) - 1;
+    }
+
+public:
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Writer thread only.
+    void record(int64_t ns) {
+        uint64_t v = std::min<uint64_t>(ns < 0 ? 0 : uint64_t(ns), MAX_VALUE);
+        bump(counts[indexOf(v)], 1);
+        bump(total, 1);
+        bump(sum, v);
+        if (v > maxValue.load(std::memory_order_relaxed)) maxValue.store(v, std::memory_order_relaxed);
+    }
+
+    // Writer thread only.
+    void clear() {
+        for (auto& c : counts) c.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        sum.store(0, std::memory_order_relaxed);
+        maxValue.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t count() const { return total.load(std::memory_order_relaxed); }
+
+    // Any thread. Percentiles come from one pass over a copy of the counts.
+    LatencySummary summary() const {
+        std::vector<uint64_t> copy(BUCKETS);
+        uint64_t n = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) n += copy[i] = counts[i].load(std::memory_order_relaxed);
+        uint64_t largest = maxValue.load(std::memory_order_relaxed);
+        uint64_t recorded = total.load(std::memory_order_relaxed);
+        LatencySummary s{n, recorded ? double(sum.load(std::memory_order_relaxed)) / double(recorded) : 0.0, 0, 0, 0,
+                         int64_t(largest)};
+        if (n == 0) return s;
+        auto at = [&](double q) {
+            uint64_t rank = std::max<uint64_t>(1, uint64_t(q * double(n) + 0.999999));
+            uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                seen += copy[i];
+                if (seen >= rank) return int64_t(std::min(highestIn(i), largest));
+            }
+            return int64_t(largest);
+        };
+        s.p50 = at(0.50);
+        s.p99 = at(0.99);
+        s.p999 = at(0.999);
+        return s;
+    }
+};
+
+// The stages of one command. A placement or modification records the first
+// three and TOTAL; a cancel only TOTAL. placeOrders/cancelOrders bursts go
+// to BATCH as a whole, since their orders validate and match interleaved.
+enum class LatencyStage : uint8_t {
+    VALIDATE, // received -> validated, including retiring the last command's finished orders
+    MATCH,    // validated -> the aggressor's matching done (or rested/armed)
+    PUBLISH,  // matched -> events published, including any stops the trades fired
+    TOTAL,    // received -> events published
+    BATCH,    // one burst, received -> events published
+};
+inline constexpr size_t LATENCY_STAGES = 5;
+
+inline const char* stageName(LatencyStage stage) {
+    switch (stage) {
+        case LatencyStage::VALIDATE: return "validate";
+        case LatencyStage::MATCH: return "match";
+        case LatencyStage::PUBLISH: return "publish";
+        case LatencyStage::TOTAL: return "total";
+        case LatencyStage::BATCH: return "batch";
+    }
+    return "?";
+}
+
+// Owned by the engine; begin/mark/end are matching-thread only, summary and
+// print work from any thread.
+class LatencyRecorder {
+private:
+    double nsPerTick;
+    uint64_t received = 0;
+    uint64_t validated = 0;
+    uint64_t matched = 0;
+    LatencyHistogram stages[LATENCY_STAGES];
+
+    int64_t toNanos(uint64_t ticks) const { return int64_t(double(ticks) * nsPerTick); }
+
+    void record(LatencyStage stage, uint64_t ticks) { stages[size_t(stage)].record(toNanos(ticks)); }
+
+public:
+    LatencyRecorder() : nsPerTick(OB_LATENCY_STATS ? TscClock::nsPerTick() : 1.0) {}
+
+    void begin() {
+        if constexpr (!OB_LATENCY_STATS) return;
+        received = TscClock::now();
+        validated = matched = 0;
+    }
+
+    // The first stamp of each kind counts: a modification validates twice.
+    void markValidated() {
+        if constexpr (!OB_LATENCY_STATS) return;
+        if (!validated) validated = TscClock::now();
+    }
+
+    void markMatched() {
+        if constexpr (!OB_LATENCY_STATS) return;
+        if (validated && !matched) matched = TscClock::now();
+    }
+
+    // Records the command ending now; returns its end-to-end latency in ns.
+    int64_t end(bool batch = false) {
+        if constexpr (!OB_LATENCY_STATS) return 0;
+        uint64_t done = TscClock::now();
+        if (batch) {
+            record(LatencyStage::BATCH, done - received);
+        } else {
+            if (validated) record(LatencyStage::VALIDATE, validated - received);
+            if (matched) {
+                record(LatencyStage::MATCH, matched - validated);
+                record(LatencyStage::PUBLISH, done - matched);
+            }
+            record(LatencyStage::TOTAL, done - received);
+        }
+        return toNanos(done - received);
+    }
+
+    LatencySummary summary(LatencyStage stage) const { return stages[size_t(stage)].summary(); }
+
+    // Writer thread only.
+    void clear() {
+        for (LatencyHistogram& h : stages) h.clear();
+    }
+
+    // One row per stage that has records.
+    void print(std::ostream& out) const {
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::left << std::setw(10) << "Stage" << std::right << std::setw(12) << "Count" << std::setw(10)
+            << "Mean" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(12)
+            << "Max" << '\n';
+        for (size_t i = 0; i < LATENCY_STAGES; ++i) {
+            LatencySummary s = stages[i].summary();
+            if (!s.count) continue;
+            out << std::left << std::setw(10) << stageName(LatencyStage(i)) << std::right << std::setw(12) << s.count
+                << std::fixed << std::setprecision(0) << std::setw(10) << s.mean << std::setw(10) << s.p50
+                << std::setw(10) << s.p99 << std::setw(10) << s.p999 << std::setw(12) << s.max << '\n';
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+};
+
+#endif
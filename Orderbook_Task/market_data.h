@@ -0,0 +1,219 @@
+#ifndef MARKET_DATA_H
+#define MARKET_DATA_H
+
+// Incremental L2 feed. The engine reports every change to a price level's
+// aggregates (an order resting, filling or leaving) as one LevelUpdate with
+// the level's new open quantity and order count; applying the updates in
+// order to an empty book reproduces the engine's depth exactly.
+//
+// Updates travel to one consumer thread through an SPSC ring and carry a
+// sequence number that rises by one per update the engine produced. The
+// matching thread never waits for the consumer:
+//   - direct mode: an update that finds the ring full is dropped and counted;
+//     the consumer sees the gap and resyncs from a depth query.
+//   - conflation mode: updates collect per level and reach the ring when the
+//     command finishes (flush()), so a level that changed several times goes
+//     out once with its latest state. Whatever does not fit waits for the next
+//     flush and keeps collapsing meanwhile. Gaps in seq are the updates folded
+//     away.
+//
+// The L3 feed (OrderFeedPublisher) carries the same changes order by order:
+// every add, execution and delete with its order ID, for consumers that track
+// queue position. It is direct only; conflating it would lose the orders.
+// l3_book_builder.h rebuilds the book from it.
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "spsc_ring.h"
+
+enum class LevelAction : uint8_t {
+    ADD = 1,    // a new level
+    CHANGE = 2, // quantity or order count changed
+    DELETE = 3, // the level is gone (quantity and count are 0)
+    CLEAR = 4   // both sides were reset (e.g. a snapshot load); rebuild from the adds after it
+};
+
+struct LevelUpdate {
+    uint64_t seq;
+    int64_t timestamp;   // command time, ns since the Unix epoch
+    int64_t price;       // ticks
+    int64_t quantity;    // lots open at the level after this update
+    uint32_t orderCount; // orders resting at the level after this update
+    uint8_t side;        // 0 = bid, 1 = ask
+    LevelAction action;
+    uint16_t reserved;
+};
+static_assert(sizeof(LevelUpdate) == 40);
+
+struct MarketDataConfig {
+    size_t ringCapacity = 1 << 16;
+    bool conflate = false;
+};
+
+struct MarketDataStats {
+    uint64_t produced = 0;  // updates generated by the engine
+    uint64_t published = 0; // updates written to the ring
+    uint64_t dropped = 0;   // direct mode: lost to a full ring
+    uint64_t conflated = 0; // conflation mode: folded into a later update
+};
+
+class MarketDataPublisher {
+private:
+    MarketDataConfig config;
+    SpscRing<LevelUpdate> ring;
+    uint64_t nextSeq = 1;
+    MarketDataStats stats;
+
+    // Conflation mode: latest pending update per level, in first-touched order.
+    std::vector<LevelUpdate> pending;
+    std::unordered_map<uint64_t, size_t> pendingIndex;
+    size_t pendingLive = 0;
+
+    static uint64_t levelKey(uint8_t side, int64_t price) { return (uint64_t(price) << 1) | side; }
+
+    bool push(const LevelUpdate& update) {
+        if (!ring.try_push(update)) return false;
+        stats.published++;
+        return true;
+    }
+
+    // A later update for a level replaces the pending one, keeping the action
+    // the consumer needs: ADD if it never saw the level, CHANGE if it did. The
+    // replaced entry becomes a hole (seq 0) and the merged one goes to the back,
+    // so pending stays in seq order. A level added and deleted within the
+    // window never reaches the consumer at all.
+    void collapse(const LevelUpdate& update) {
+        if (update.action == LevelAction::CLEAR) {
+            stats.conflated += pendingLive;
+            pending.clear();
+            pendingIndex.clear();
+            pending.push_back(update);
+            pendingLive = 1;
+            return;
+        }
+        auto [it, inserted] = pendingIndex.try_emplace(levelKey(update.side, update.price), pending.size());
+        if (inserted) {
+            pending.push_back(update);
+            pendingLive++;
+            return;
+        }
+        LevelUpdate merged = update;
+        LevelAction first = pending[it->second].action;
+        pending[it->second].seq = 0;
+        stats.conflated++;
+        if (first == LevelAction::ADD && update.action == LevelAction::DELETE) {
+            pendingIndex.erase(it);
+            pendingLive--;
+            stats.conflated++;
+            return;
+        }
+        if (first == LevelAction::ADD) merged.action = LevelAction::ADD;
+        else if (first == LevelAction::DELETE) merged.action = LevelAction::CHANGE;
+        it->second = pending.size();
+        pending.push_back(merged);
+    }
+
+public:
+    explicit MarketDataPublisher(const MarketDataConfig& config_ = {})
+        : config(config_), ring(config_.ringCapacity) {}
+
+    MarketDataPublisher(const MarketDataPublisher&) = delete;
+    MarketDataPublisher& operator=(const MarketDataPublisher&) = delete;
+
+    // Engine thread.
+    void publish(int64_t timestamp, uint8_t side, LevelAction action, int64_t price, int64_t quantity,
+                 uint32_t orderCount) {
+        LevelUpdate update{nextSeq++, timestamp, price, quantity, orderCount, side, action, 0};
+        stats.produced++;
+        if (config.conflate) collapse(update);
+        else if (!push(update)) stats.dropped++;
+    }
+
+    // Engine thread, at the end of each command: moves pending updates into
+    // the ring while it has room.
+    void flush() {
+        size_t done = 0;
+        for (; done < pending.size(); ++done) {
+            const LevelUpdate& update = pending[done];
+            if (update.seq == 0) continue;
+            if (!push(update)) break;
+            if (update.action != LevelAction::CLEAR) pendingIndex.erase(levelKey(update.side, update.price));
+            pendingLive--;
+        }
+        if (done == 0) return;
+        pending.erase(pending.begin(), pending.begin() + done);
+        for (auto& [key, index] : pendingIndex) index -= done; // only what did not fit is left
+    }
+
+    // Consumer thread: next update, false when none is waiting.
+    bool poll(LevelUpdate& out) { return ring.try_pop(out); }
+
+    // Engine thread (or once both threads are done).
+    uint64_t nextSequence() const { return nextSeq; }
+    size_t pendingCount() const { return pendingLive; } // conflation mode: waiting for ring space
+    const MarketDataStats& getStats() const { return stats; }
+    bool conflating() const { return config.conflate; }
+};
+
+enum class OrderEventType : uint8_t {
+    ADD = 1,     // an order rests: quantity is its open quantity, price its limit
+    EXECUTE = 2, // a resting order traded: quantity filled, price the trade price;
+                 // the order leaves the book when nothing is left open
+    REDUCE = 3,  // open quantity lowered in place, keeping priority (this engine
+                 // modifies by delete + add, so only other feeds send it)
+    DELETE = 4,  // cancelled or unlinked: quantity is what was still open
+    CLEAR = 5    // the book was reset (e.g. a snapshot load); adds follow
+};
+
+struct OrderEvent {
+    uint64_t seq;
+    int64_t timestamp; // command time, ns since the Unix epoch
+    int64_t price;     // ticks
+    int64_t quantity;  // lots
+    int32_t orderId;
+    uint8_t side;      // 0 = buy, 1 = sell
+    OrderEventType type;
+    uint16_t reserved;
+};
+static_assert(sizeof(OrderEvent) == 40);
+
+struct OrderFeedStats {
+    uint64_t produced = 0;
+    uint64_t published = 0;
+    uint64_t dropped = 0; // lost to a full ring; the consumer sees the seq gap
+};
+
+class OrderFeedPublisher {
+private:
+    SpscRing<OrderEvent> ring;
+    uint64_t nextSeq = 1;
+    OrderFeedStats stats;
+
+public:
+    explicit OrderFeedPublisher(size_t ringCapacity = 1 << 16) : ring(ringCapacity) {}
+
+    OrderFeedPublisher(const OrderFeedPublisher&) = delete;
+    OrderFeedPublisher& operator=(const OrderFeedPublisher&) = delete;
+
+    // Engine thread.
+    void publish(int64_t timestamp, OrderEventType type, uint8_t side, int32_t orderId, int64_t price,
+                 int64_t quantity) {
+        stats.produced++;
+        if (ring.try_push(OrderEvent{nextSeq++, timestamp, price, quantity, orderId, side, type, 0})) {
+            stats.published++;
+        } else {
+            stats.dropped++;
+        }
+    }
+
+    // Consumer thread: next event, false when none is waiting.
+    bool poll(OrderEvent& out) { return ring.try_pop(out); }
+
+    // Engine thread (or once both threads are done).
+    uint64_t nextSequence() const { return nextSeq; }
+    const OrderFeedStats& getStats() const { return stats; }
+};
+
+#endif
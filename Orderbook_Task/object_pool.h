@@ -0,0 +1,104 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+// Preallocated storage for the matching engine's hot-path objects. Everything
+// is reserved up front; running past the configured capacity is handled by an
+// explicit OverflowPolicy and counted, so a growing pool shows up in stats
+// rather than as a silent allocation inside matching.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+enum class OverflowPolicy {
+    GROW,      // allocate another slab or chunk (counted in stats.grows)
+    REJECT,    // refuse the allocation (counted in stats.rejects)
+    OVERWRITE  // TradeStore only: drop the oldest chunk of trades (counted in stats.overwrites)
+};
+
+struct PoolStats {
+    size_t capacity = 0;
+    size_t inUse = 0;
+    size_t highWater = 0;
+    size_t grows = 0;
+    size_t rejects = 0;
+    size_t overwrites = 0;
+};
+
+// Fixed-size slots carved from slabs. Objects are addressed by 32-bit handles
+// and never move, so pointers into the pool stay valid until release().
+template <typename T>
+class SlabPool {
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    std::vector<uint32_t> freeList;
+    size_t slabSize;
+    OverflowPolicy policy;
+    PoolStats stats;
+
+    void addSlab() {
+        uint32_t first = uint32_t(slabs.size() * slabSize);
+        slabs.emplace_back(new Slot[slabSize]);
+        freeList.reserve(freeList.size() + slabSize);
+        for (size_t i = slabSize; i-- > 0;) freeList.push_back(first + uint32_t(i));
+        stats.capacity += slabSize;
+    }
+
+    T* slot(uint32_t handle) const {
+        return std::launder(reinterpret_cast<T*>(slabs[handle / slabSize][handle % slabSize].storage));
+    }
+
+public:
+    static constexpr uint32_t INVALID = UINT32_MAX;
+
+    explicit SlabPool(size_t capacity = 1 << 16, OverflowPolicy policy_ = OverflowPolicy::GROW,
+                      size_t slabSize_ = 4096)
+        : slabSize(std::max<size_t>(1, capacity ? std::min(slabSize_, capacity) : slabSize_)), policy(policy_) {
+        while (stats.capacity < capacity) addSlab();
+    }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    // Live objects are owned by the caller and must be released before the
+    // pool goes away; the pool does not track which slots are occupied.
+    ~SlabPool() = default;
+
+    template <typename... Args>
+    uint32_t allocate(Args&&... args) {
+        if (freeList.empty()) {
+            if (policy != OverflowPolicy::GROW) {
+                stats.rejects++;
+                return INVALID;
+            }
+            addSlab();
+            stats.grows++;
+        }
+        uint32_t handle = freeList.back();
+        freeList.pop_back();
+        new (slot(handle)) T(std::forward<Args>(args)...);
+        if (++stats.inUse > stats.highWater) stats.highWater = stats.inUse;
+        return handle;
+    }
+
+    void release(uint32_t handle) {
+        slot(handle)->~T();
+        freeList.push_back(handle);
+        stats.inUse--;
+    }
+
+    T& operator[](uint32_t handle) { return *slot(handle); }
+    const T& operator[](uint32_t handle) const { return *slot(handle); }
+
+    const PoolStats& getStats() const { return stats; }
+};
+
+#endif
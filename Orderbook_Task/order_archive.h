@@ -0,0 +1,219 @@
+#ifndef ORDER_ARCHIVE_H
+#define ORDER_ARCHIVE_H
+
+// Append-only history of finished orders (filled, cancelled, rejected, or
+// market orders done executing), so the live pool and ID index only hold
+// orders that can still change. Each order is one 64-byte record.
+//
+// Records collect in fixed-size chunks; memory keeps `capacity` of them
+// (rounded up to whole chunks). With an archive file, the oldest full chunk
+// is appended to it when memory is full and stays findable there; without
+// one, memory grows, or under OVERWRITE the oldest chunk is dropped. Every chunk keeps its ID range, so find() reads only
+// the chunks that can hold the ID, newest first, but it is still a scan: a
+// slow path for reports and audits, not for matching.
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "async_logger.h"
+#include "object_pool.h"
+
+struct ArchivedOrder {
+    int64_t price;    // ticks
+    int64_t quantity; // lots
+    int64_t filledQty;
+    int64_t stopPrice;
+    int64_t timestamp; // ns since the Unix epoch
+    int64_t latency;   // ns
+    int32_t id;
+    uint32_t client; // engine's interned client index
+    uint8_t side;    // 0 = buy, 1 = sell
+    uint8_t type;
+    uint8_t status;
+    uint8_t reserved[5];
+};
+static_assert(sizeof(ArchivedOrder) == 64);
+
+struct OrderArchiveStats {
+    uint64_t archived = 0;
+    uint64_t inMemory = 0;
+    uint64_t spilled = 0; // records written to the archive file
+    uint64_t spillFailures = 0;
+    uint64_t chunkGrows = 0; // chunks added past capacity (no archive file)
+};
+
+class OrderArchive {
+private:
+    struct Chunk {
+        std::vector<ArchivedOrder> records;
+        int32_t minId = std::numeric_limits<int32_t>::max();
+        int32_t maxId = std::numeric_limits<int32_t>::min();
+
+        explicit Chunk(size_t n) { records.reserve(n); }
+
+        void reset() {
+            records.clear();
+            minId = std::numeric_limits<int32_t>::max();
+            maxId = std::numeric_limits<int32_t>::min();
+        }
+    };
+
+    struct SpilledChunk {
+        off_t offset;
+        uint32_t count;
+        int32_t minId;
+        int32_t maxId;
+    };
+
+    size_t chunkRecords;
+    size_t chunkBudget; // chunks memory may hold
+    OverflowPolicy policy; // without a file: GROW keeps every record, OVERWRITE the newest
+    std::string path;
+    int fd = -1;
+    off_t fileSize = 0;
+    std::deque<std::unique_ptr<Chunk>> live; // oldest first; back() takes appends
+    std::vector<std::unique_ptr<Chunk>> spare;
+    std::vector<SpilledChunk> spilled;
+    std::vector<ArchivedOrder> scratch;
+    OrderArchiveStats stats;
+
+    bool spill(const Chunk& chunk) {
+        size_t bytes = chunk.records.size() * sizeof(ArchivedOrder);
+        const char* p = reinterpret_cast<const char*>(chunk.records.data());
+        off_t at = fileSize;
+        for (size_t done = 0; done < bytes;) {
+            ssize_t n = ::pwrite(fd, p + done, bytes - done, at + off_t(done));
+            if (n <= 0) return false;
+            done += size_t(n);
+        }
+        fileSize += off_t(bytes);
+        spilled.push_back({at, uint32_t(chunk.records.size()), chunk.minId, chunk.maxId});
+        return true;
+    }
+
+    bool load(const SpilledChunk& s) {
+        scratch.resize(s.count);
+        size_t bytes = size_t(s.count) * sizeof(ArchivedOrder);
+        char* p = reinterpret_cast<char*>(scratch.data());
+        for (size_t done = 0; done < bytes;) {
+            ssize_t n = ::pread(fd, p + done, bytes - done, s.offset + off_t(done));
+            if (n <= 0) {
+                OB_LOG_ERROR("❌ Cannot read order archive %s", path);
+                return false;
+            }
+            done += size_t(n);
+        }
+        return true;
+    }
+
+    // A fresh chunk at the back, spilling or growing to make room.
+    void openChunk() {
+        if (spare.empty()) {
+            if (fd >= 0 && live.size() >= chunkBudget) {
+                Chunk& oldest = *live.front();
+                if (spill(oldest)) {
+                    stats.spilled += oldest.records.size();
+                } else {
+                    stats.spillFailures++;
+                    OB_LOG_ERROR("❌ Cannot write order archive %s; %zu orders dropped", path, oldest.records.size());
+                }
+                stats.inMemory -= oldest.records.size();
+                spare.push_back(std::move(live.front()));
+                live.pop_front();
+            } else if (policy == OverflowPolicy::OVERWRITE && live.size() >= chunkBudget) {
+                stats.inMemory -= live.front()->records.size();
+                spare.push_back(std::move(live.front()));
+                live.pop_front();
+            } else {
+                spare.push_back(std::make_unique<Chunk>(chunkRecords));
+                if (live.size() >= chunkBudget) stats.chunkGrows++;
+            }
+        }
+        live.push_back(std::move(spare.back()));
+        spare.pop_back();
+        live.back()->reset();
+    }
+
+    template <typename Records>
+    static bool findIn(const Records& records, int32_t id, ArchivedOrder& out) {
+        for (size_t i = records.size(); i-- > 0;) {
+            if (records[i].id == id) {
+                out = records[i];
+                return true;
+            }
+        }
+        return false;
+    }
+
+public:
+    // An empty path keeps everything in memory. The file is truncated: it
+    // holds this engine run's archive.
+    explicit OrderArchive(size_t capacity = 1 << 16, std::string path_ = {}, size_t chunkRecords_ = 4096,
+                          OverflowPolicy policy_ = OverflowPolicy::GROW)
+        : chunkRecords(std::max<size_t>(1, std::min(chunkRecords_, std::max<size_t>(capacity, 1)))),
+          chunkBudget(std::max<size_t>(1, (capacity + chunkRecords - 1) / chunkRecords)),
+          policy(policy_),
+          path(std::move(path_)) {
+        for (size_t i = 0; i < chunkBudget; ++i) spare.push_back(std::make_unique<Chunk>(chunkRecords));
+        if (!path.empty()) {
+            fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) OB_LOG_ERROR("❌ Cannot open order archive %s; keeping orders in memory", path);
+        }
+    }
+
+    ~OrderArchive() {
+        if (fd >= 0) ::close(fd);
+    }
+
+    OrderArchive(const OrderArchive&) = delete;
+    OrderArchive& operator=(const OrderArchive&) = delete;
+
+    void append(const ArchivedOrder& order) {
+        if (live.empty() || live.back()->records.size() == chunkRecords) openChunk();
+        Chunk& chunk = *live.back();
+        chunk.records.push_back(order);
+        chunk.minId = std::min(chunk.minId, order.id);
+        chunk.maxId = std::max(chunk.maxId, order.id);
+        stats.archived++;
+        stats.inMemory++;
+    }
+
+    // Latest record for id: memory first, then the file.
+    bool find(int32_t id, ArchivedOrder& out) {
+        for (size_t c = live.size(); c-- > 0;) {
+            const Chunk& chunk = *live[c];
+            if (id >= chunk.minId && id <= chunk.maxId && findIn(chunk.records, id, out)) return true;
+        }
+        for (size_t c = spilled.size(); c-- > 0;) {
+            const SpilledChunk& s = spilled[c];
+            if (id >= s.minId && id <= s.maxId && load(s) && findIn(scratch, id, out)) return true;
+        }
+        return false;
+    }
+
+    // Forgets every record, e.g. when the book is replaced by a snapshot, and
+    // truncates the archive file. Chunks are kept for reuse.
+    void clear() {
+        while (!live.empty()) {
+            spare.push_back(std::move(live.back()));
+            live.pop_back();
+        }
+        spilled.clear();
+        if (fd >= 0 && ::ftruncate(fd, 0) != 0) OB_LOG_ERROR("❌ Cannot truncate order archive %s", path);
+        fileSize = 0;
+        stats = OrderArchiveStats{};
+    }
+
+    bool empty() const { return stats.archived == 0; }
+    const OrderArchiveStats& getStats() const { return stats; }
+};
+
+#endif
@@ -0,0 +1,131 @@
+#ifndef ORDER_INDEX_H
+#define ORDER_INDEX_H
+
+// Order ID -> 32-bit pool handle. The engine hands out IDs sequentially from
+// 1, so the index is direct-mapped instead of hashed: a directory of
+// fixed-size pages of handles, a page allocated when the first ID in its
+// range arrives and freed when the last one is erased. The last page freed
+// is kept as a spare, already cleared, for the next page needed, so an order
+// alone on its page (a market order on a quiet book, say) does not cost the
+// next order a 256 KB allocation and clear. A lookup is two dependent loads
+// (directory, page) with no hashing, probing or per-order node; prefetch()
+// issues the page load ahead of time for batched lookups.
+//
+// Memory is 4 bytes per ID in a live page plus a 16-byte directory entry per
+// page, so 100M live IDs take about 400 MB, a fraction of a node-based map's
+// footprint. Erased IDs keep their page until all its IDs are gone, and the
+// spare page adds 256 KB.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class OrderIndex {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    static constexpr size_t PAGE_BITS = 16;
+    static constexpr size_t PAGE_SIZE = size_t(1) << PAGE_BITS; // IDs per page
+
+private:
+    struct Page {
+        std::unique_ptr<uint32_t[]> handles;
+        uint32_t live = 0;
+    };
+
+    std::vector<Page> pages;
+    std::unique_ptr<uint32_t[]> spare; // an empty page, all NONE
+    size_t live = 0;
+    size_t pagesAllocated = 0;
+
+    static size_t pageOf(int id) { return size_t(uint32_t(id)) >> PAGE_BITS; }
+    static size_t slotOf(int id) { return size_t(uint32_t(id)) & (PAGE_SIZE - 1); }
+
+public:
+    OrderIndex() = default;
+    OrderIndex(const OrderIndex&) = delete;
+    OrderIndex& operator=(const OrderIndex&) = delete;
+
+    // Sizes the directory for IDs up to maxId; pages still come on demand.
+    void reserve(size_t maxId) {
+        if ((maxId >> PAGE_BITS) + 1 > pages.size()) pages.resize((maxId >> PAGE_BITS) + 1);
+    }
+
+    // Maps id (> 0) to handle, replacing any previous handle for it.
+    void insert(int id, uint32_t handle) {
+        size_t p = pageOf(id);
+        if (p >= pages.size()) pages.resize(std::max(p + 1, pages.size() * 2));
+        Page& page = pages[p];
+        if (!page.handles) {
+            if (spare) {
+                page.handles = std::move(spare);
+            } else {
+                page.handles.reset(new uint32_t[PAGE_SIZE]);
+                std::fill(page.handles.get(), page.handles.get() + PAGE_SIZE, NONE);
+            }
+            pagesAllocated++;
+        }
+        uint32_t& slot = page.handles[slotOf(id)];
+        if (slot == NONE) {
+            page.live++;
+            live++;
+        }
+        slot = handle;
+    }
+
+    // The handle for id, or NONE.
+    uint32_t find(int id) const {
+        size_t p = pageOf(id);
+        if (id <= 0 || p >= pages.size() || !pages[p].handles) return NONE;
+        return pages[p].handles[slotOf(id)];
+    }
+
+    // Pulls id's slot towards the cache; call a few lookups ahead.
+    void prefetch(int id) const {
+        size_t p = pageOf(id);
+        if (p < pages.size() && pages[p].handles) __builtin_prefetch(&pages[p].handles[slotOf(id)]);
+    }
+
+    bool erase(int id) {
+        size_t p = pageOf(id);
+        if (id <= 0 || p >= pages.size() || !pages[p].handles) return false;
+        Page& page = pages[p];
+        uint32_t& slot = page.handles[slotOf(id)];
+        if (slot == NONE) return false;
+        slot = NONE;
+        live--;
+        if (--page.live == 0) {
+            if (!spare) spare = std::move(page.handles);
+            else page.handles.reset();
+            pagesAllocated--;
+        }
+        return true;
+    }
+
+    // f(id, handle) for every entry, in ID order.
+    template <typename F>
+    void forEach(F&& f) const {
+        for (size_t p = 0; p < pages.size(); ++p) {
+            if (!pages[p].handles) continue;
+            for (size_t s = 0; s < PAGE_SIZE; ++s) {
+                uint32_t handle = pages[p].handles[s];
+                if (handle != NONE) f(int((p << PAGE_BITS) | s), handle);
+            }
+        }
+    }
+
+    void clear() {
+        for (Page& page : pages) page = Page{};
+        live = 0;
+        pagesAllocated = 0;
+    }
+
+    size_t size() const { return live; }
+    bool empty() const { return live == 0; }
+    size_t memoryBytes() const {
+        return pages.capacity() * sizeof(Page) + (pagesAllocated + (spare ? 1 : 0)) * PAGE_SIZE * sizeof(uint32_t);
+    }
+};
+
+#endif
@@ -0,0 +1,422 @@
+#ifndef PRICE_LADDER_H
+#define PRICE_LADDER_H
+
+// Direct-indexed price ladder: one contiguous slot per tick inside a movable
+// window, with a two-level occupancy bitmap so the next non-empty level is
+// found with a couple of ctz/clz instructions instead of a tree walk.
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class OccupancyBitmap {
+private:
+    std::vector<uint64_t> leaf;    // bit i -> slot i occupied
+    std::vector<uint64_t> summary; // bit w -> leaf[w] != 0
+
+public:
+    static constexpr int64_t NONE = -1;
+
+    explicit OccupancyBitmap(size_t bits = 0) { resize(bits); }
+
+    void resize(size_t bits) {
+        leaf.assign((bits + 63) / 64, 0);
+        summary.assign((leaf.size() + 63) / 64, 0);
+    }
+
+    void set(size_t i) {
+        leaf[i >> 6] |= 1ULL << (i & 63);
+        summary[i >> 12] |= 1ULL << ((i >> 6) & 63);
+    }
+
+    void reset(size_t i) {
+        leaf[i >> 6] &= ~(1ULL << (i & 63));
+        if (!leaf[i >> 6]) summary[i >> 12] &= ~(1ULL << ((i >> 6) & 63));
+    }
+
+    bool test(size_t i) const { return leaf[i >> 6] >> (i & 63) & 1; }
+
+    // Lowest set bit >= from, or NONE.
+    int64_t findNext(int64_t from) const {
+        if (from < 0) from = 0;
+        size_t w = size_t(from) >> 6;
+        if (w >= leaf.size()) return NONE;
+        uint64_t bits = leaf[w] & (~0ULL << (from & 63));
+        if (bits) return int64_t(w << 6) + std::countr_zero(bits);
+
+        size_t s = (w + 1) >> 6;
+        if (s >= summary.size()) return NONE;
+        uint64_t words = summary[s] & (~0ULL << ((w + 1) & 63));
+        while (!words) {
+            if (++s == summary.size()) return NONE;
+            words = summary[s];
+        }
+        size_t lw = (s << 6) + std::countr_zero(words);
+        return int64_t(lw << 6) + std::countr_zero(leaf[lw]);
+    }
+
+    // Highest set bit <= from, or NONE.
+    int64_t findPrev(int64_t from) const {
+        if (from < 0 || leaf.empty()) return NONE;
+        if (size_t(from) >= leaf.size() * 64) from = int64_t(leaf.size() * 64) - 1;
+        size_t w = size_t(from) >> 6;
+        uint64_t bits = leaf[w] & (~0ULL >> (63 - (from & 63)));
+        if (bits) return int64_t(w << 6) + 63 - std::countl_zero(bits);
+        if (w == 0) return NONE;
+
+        size_t s = (w - 1) >> 6;
+        uint64_t words = summary[s] & (~0ULL >> (63 - ((w - 1) & 63)));
+        while (!words) {
+            if (s-- == 0) return NONE;
+            words = summary[s];
+        }
+        size_t lw = (s << 6) + 63 - std::countl_zero(words);
+        return int64_t(lw << 6) + 63 - std::countl_zero(leaf[lw]);
+    }
+};
+
+// Fenwick tree over ladder slots in priority (best-first) order, holding open
+// quantity and notional (price * quantity) so cumulative depth, the price a
+// sweep reaches and its cost are all O(log levels).
+class DepthFenwick {
+private:
+    std::vector<int64_t> qty;      // 1-based
+    std::vector<int64_t> notional; // 1-based
+    size_t topStep = 0;
+
+public:
+    void reset(size_t n) {
+        qty.assign(n + 1, 0);
+        notional.assign(n + 1, 0);
+        topStep = n ? std::bit_floor(n) : 0;
+    }
+
+    size_t size() const { return qty.size() - 1; }
+
+    void add(size_t pos, int64_t dq, int64_t dn) {
+        for (size_t i = pos + 1; i < qty.size(); i += i & -i) {
+            qty[i] += dq;
+            notional[i] += dn;
+        }
+    }
+
+    // Sums over the first `count` positions.
+    void prefix(size_t count, int64_t& q, int64_t& n) const {
+        q = n = 0;
+        for (size_t i = count; i > 0; i -= i & -i) {
+            q += qty[i];
+            n += notional[i];
+        }
+    }
+
+    // First position where the running quantity reaches target (size() if it
+    // never does), with the sums of the positions before it.
+    size_t lowerBound(int64_t target, int64_t& qBefore, int64_t& nBefore) const {
+        size_t pos = 0;
+        qBefore = nBefore = 0;
+        for (size_t step = topStep; step; step >>= 1) {
+            if (pos + step < qty.size() && qBefore + qty[pos + step] < target) {
+                pos += step;
+                qBefore += qty[pos];
+                nBefore += notional[pos];
+            }
+        }
+        return pos;
+    }
+
+    // Linear-time rebuild from per-position values.
+    template <typename QtyAt, typename PriceAt>
+    void build(size_t n, QtyAt qtyAt, PriceAt priceAt) {
+        reset(n);
+        for (size_t i = 1; i <= n; ++i) {
+            int64_t q = qtyAt(i - 1);
+            qty[i] += q;
+            notional[i] += q * priceAt(i - 1);
+            size_t parent = i + (i & -i);
+            if (parent <= n) {
+                qty[parent] += qty[i];
+                notional[parent] += notional[i];
+            }
+        }
+    }
+};
+
+// Result of walking one side best-first for a quantity. cost is in ticks * lots.
+struct SweepResult {
+    int64_t filled = 0;
+    int64_t lastPrice = 0;
+    int64_t cost = 0;
+};
+
+// One side of a book. Slot i holds the level at price base + i; the window
+// recenters (and grows up to maxLevels) when a price falls outside it. Prices
+// that would need a wider window than maxLevels go to a small sorted overflow
+// map so a fat-finger price cannot blow the ladder up.
+//
+// operator[] marks a level occupied, so call it only to insert into the level.
+// Empty levels are dropped with erase(); their storage is reused in place, so
+// Level needs clear() besides being default-constructible and movable.
+//
+// Open quantity per level is reported through addDepth() and indexed by a
+// Fenwick tree for depthUpTo()/sweep().
+template <typename Level, bool IsBid>
+class PriceLadder {
+private:
+    using Better = std::conditional_t<IsBid, std::greater<int64_t>, std::less<int64_t>>;
+
+    struct OverflowLevel {
+        Level level;
+        int64_t depth = 0;
+    };
+
+    std::vector<Level> levels;
+    std::vector<int64_t> depth; // open quantity per slot
+    OccupancyBitmap occupied;
+    DepthFenwick depthIndex;
+    std::map<int64_t, OverflowLevel, Better> overflow;
+    int64_t base = 0;
+    int64_t bestIdx = OccupancyBitmap::NONE;
+    int64_t totalQty = 0;
+    size_t levelCount = 0;
+    size_t maxLevels;
+    size_t recenterCount = 0;
+
+    size_t capacity() const { return levels.size(); }
+    bool inWindow(int64_t price) const { return price >= base && price < base + int64_t(capacity()); }
+    // Overflow prices sort entirely before or after the window.
+    bool beforeWindow(int64_t price) const { return IsBid ? price >= base + int64_t(capacity()) : price < base; }
+
+    // Fenwick position of a slot: its rank in best-first order.
+    size_t rank(int64_t idx) const { return IsBid ? capacity() - 1 - size_t(idx) : size_t(idx); }
+    int64_t slotOfRank(size_t r) const { return IsBid ? int64_t(capacity() - 1 - r) : int64_t(r); }
+
+    int64_t firstIdx() const {
+        return IsBid ? occupied.findPrev(int64_t(capacity()) - 1) : occupied.findNext(0);
+    }
+    int64_t nextIdx(int64_t idx) const {
+        return IsBid ? occupied.findPrev(idx - 1) : occupied.findNext(idx + 1);
+    }
+    int64_t lastIdx() const {
+        return IsBid ? occupied.findNext(0) : occupied.findPrev(int64_t(capacity()) - 1);
+    }
+
+    void rebuildDepthIndex() {
+        depthIndex.build(capacity(), [&](size_t r) { return depth[slotOfRank(r)]; },
+                         [&](size_t r) { return base + slotOfRank(r); });
+    }
+
+    // Moves the window so `price` fits, doubling it (up to maxLevels) when the
+    // occupied span plus the new price needs more room. Leaves the window alone
+    // if even maxLevels is not enough; the caller then uses the overflow map.
+    void recenter(int64_t price) {
+        int64_t lo = price, hi = price;
+        int64_t first = occupied.findNext(0);
+        if (first != OccupancyBitmap::NONE) {
+            lo = std::min(lo, base + first);
+            hi = std::max(hi, base + occupied.findPrev(int64_t(capacity()) - 1));
+        }
+        size_t span = size_t(hi - lo + 1);
+        size_t newCap = capacity();
+        while (newCap < 2 * span && newCap < maxLevels) newCap *= 2;
+        if (span > newCap) return;
+        int64_t newBase = lo - int64_t(newCap - span) / 2;
+
+        std::vector<Level> moved(newCap);
+        std::vector<int64_t> movedDepth(newCap, 0);
+        OccupancyBitmap bits(newCap);
+        for (int64_t i = first; i != OccupancyBitmap::NONE; i = occupied.findNext(i + 1)) {
+            size_t to = size_t(base + i - newBase);
+            moved[to] = std::move(levels[i]);
+            movedDepth[to] = depth[i];
+            bits.set(to);
+        }
+        levels.swap(moved);
+        depth.swap(movedDepth);
+        occupied = std::move(bits);
+        base = newBase;
+
+        for (auto it = overflow.begin(); it != overflow.end();) {
+            if (!inWindow(it->first)) { ++it; continue; }
+            size_t to = size_t(it->first - base);
+            levels[to] = std::move(it->second.level);
+            depth[to] = it->second.depth;
+            occupied.set(to);
+            it = overflow.erase(it);
+        }
+        bestIdx = firstIdx();
+        rebuildDepthIndex();
+        ++recenterCount;
+    }
+
+    static void take(SweepResult& result, int64_t& remaining, int64_t price, int64_t available) {
+        int64_t qty = std::min(remaining, available);
+        if (qty <= 0) return;
+        result.filled += qty;
+        result.cost += qty * price;
+        result.lastPrice = price;
+        remaining -= qty;
+    }
+
+public:
+    explicit PriceLadder(size_t initialLevels = 4096, size_t maxLevels_ = 1 << 20)
+        : levels(std::bit_ceil(initialLevels)), depth(std::bit_ceil(initialLevels), 0),
+          occupied(std::bit_ceil(initialLevels)),
+          maxLevels(std::max(std::bit_ceil(initialLevels), maxLevels_)) {
+        depthIndex.reset(capacity());
+    }
+
+    bool empty() const { return levelCount == 0; }
+    size_t size() const { return levelCount; }
+    size_t windowLevels() const { return capacity(); }
+    size_t recenters() const { return recenterCount; }
+
+    int64_t bestPrice() const {
+        if (overflow.empty()) return base + bestIdx;
+        if (bestIdx == OccupancyBitmap::NONE) return overflow.begin()->first;
+        return Better{}(overflow.begin()->first, base + bestIdx) ? overflow.begin()->first : base + bestIdx;
+    }
+
+    Level& best() {
+        int64_t price = bestPrice();
+        return inWindow(price) ? levels[price - base] : overflow.begin()->second.level;
+    }
+
+    Level* find(int64_t price) {
+        if (inWindow(price)) return occupied.test(size_t(price - base)) ? &levels[price - base] : nullptr;
+        auto it = overflow.find(price);
+        return it == overflow.end() ? nullptr : &it->second.level;
+    }
+
+    Level& operator[](int64_t price) {
+        if (!inWindow(price)) {
+            if (auto it = overflow.find(price); it != overflow.end()) return it->second.level;
+            recenter(price);
+            if (!inWindow(price)) {
+                ++levelCount;
+                return overflow[price].level;
+            }
+        }
+        size_t idx = size_t(price - base);
+        if (!occupied.test(idx)) {
+            occupied.set(idx);
+            ++levelCount;
+            if (bestIdx == OccupancyBitmap::NONE || (IsBid ? int64_t(idx) > bestIdx : int64_t(idx) < bestIdx)) {
+                bestIdx = int64_t(idx);
+            }
+        }
+        return levels[idx];
+    }
+
+    void erase(int64_t price) {
+        addDepth(price, -depthAt(price));
+        if (!inWindow(price)) {
+            levelCount -= overflow.erase(price);
+            return;
+        }
+        size_t idx = size_t(price - base);
+        if (!occupied.test(idx)) return;
+        levels[idx].clear();
+        occupied.reset(idx);
+        --levelCount;
+        if (int64_t(idx) == bestIdx) bestIdx = nextIdx(bestIdx);
+    }
+
+    void clear() {
+        for (int64_t i = firstIdx(); i != OccupancyBitmap::NONE; i = nextIdx(i)) levels[i].clear();
+        occupied.resize(capacity());
+        std::fill(depth.begin(), depth.end(), 0);
+        depthIndex.reset(capacity());
+        overflow.clear();
+        bestIdx = OccupancyBitmap::NONE;
+        totalQty = 0;
+        levelCount = 0;
+    }
+
+    // Visits levels best-first; f(price, level) returns false to stop.
+    template <typename F>
+    void forEach(F&& f) {
+        auto ov = overflow.begin();
+        for (int64_t i = firstIdx(); i != OccupancyBitmap::NONE; i = nextIdx(i)) {
+            for (; ov != overflow.end() && Better{}(ov->first, base + i); ++ov) {
+                if (!f(ov->first, ov->second.level)) return;
+            }
+            if (!f(base + i, levels[i])) return;
+        }
+        for (; ov != overflow.end(); ++ov) {
+            if (!f(ov->first, ov->second.level)) return;
+        }
+    }
+
+    // Depth bookkeeping: the owner reports every change in a level's open
+    // quantity. The level must already exist (operator[] first).
+    void addDepth(int64_t price, int64_t delta) {
+        if (!delta) return;
+        totalQty += delta;
+        if (!inWindow(price)) {
+            overflow[price].depth += delta;
+            return;
+        }
+        size_t idx = size_t(price - base);
+        depth[idx] += delta;
+        depthIndex.add(rank(int64_t(idx)), delta, delta * price);
+    }
+
+    int64_t depthAt(int64_t price) const {
+        if (inWindow(price)) return depth[price - base];
+        auto it = overflow.find(price);
+        return it == overflow.end() ? 0 : it->second.depth;
+    }
+
+    int64_t totalDepth() const { return totalQty; }
+
+    // Open quantity at `price` or better.
+    int64_t depthUpTo(int64_t price) const {
+        int64_t sum = 0;
+        for (const auto& [p, entry] : overflow) {
+            if (Better{}(price, p)) break;
+            sum += entry.depth;
+        }
+        if (Better{}(price, IsBid ? base + int64_t(capacity()) - 1 : base)) return sum;
+        int64_t q, n;
+        if (inWindow(price)) depthIndex.prefix(rank(price - base) + 1, q, n);
+        else depthIndex.prefix(capacity(), q, n);
+        return sum + q;
+    }
+
+    // Walks best-first for up to qty without touching the book.
+    SweepResult sweep(int64_t qty) const {
+        SweepResult result;
+        int64_t remaining = qty;
+        auto ov = overflow.begin();
+        for (; ov != overflow.end() && remaining > 0 && beforeWindow(ov->first); ++ov) {
+            take(result, remaining, ov->first, ov->second.depth);
+        }
+        if (remaining > 0) {
+            int64_t qBefore, nBefore;
+            size_t r = depthIndex.lowerBound(remaining, qBefore, nBefore);
+            if (r < capacity()) {
+                int64_t price = base + slotOfRank(r);
+                result.filled += remaining;
+                result.cost += nBefore + (remaining - qBefore) * price;
+                result.lastPrice = price;
+                remaining = 0;
+            } else if (qBefore > 0) {
+                result.filled += qBefore;
+                result.cost += nBefore;
+                result.lastPrice = base + lastIdx();
+                remaining -= qBefore;
+            }
+        }
+        for (; ov != overflow.end() && remaining > 0; ++ov) {
+            take(result, remaining, ov->first, ov->second.depth);
+        }
+        return result;
+    }
+};
+
+#endif
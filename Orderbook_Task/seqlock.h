@@ -0,0 +1,77 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+// Single-writer sequence lock for small trivially copyable records. The writer
+// never waits: it bumps the sequence to odd, stores the record and bumps it to
+// even again. Readers copy the record and keep the copy only if the sequence
+// was the same even value before and after, so any number of them can read
+// from other threads without taking a lock or writing a shared line.
+//
+// The record is held as relaxed atomic words, which keeps the concurrent
+// copy well-defined (and quiet under ThreadSanitizer) while compiling to
+// plain loads and stores.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "spsc_ring.h" // CACHE_LINE_SIZE
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> words[WORDS] = {};
+
+public:
+    SeqLock() = default;
+    explicit SeqLock(const T& initial) { store(initial); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Writer thread only.
+    void store(const T& value) {
+        uint64_t buffer[WORDS] = {};
+        std::memcpy(buffer, &value, sizeof(T));
+        uint64_t s = sequence.load(std::memory_order_relaxed);
+        sequence.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) words[i].store(buffer[i], std::memory_order_relaxed);
+        sequence.store(s + 2, std::memory_order_release);
+    }
+
+    // One attempt; false if a write was in progress or happened meanwhile.
+    // Never waits, so a reader on a latency-critical path can fall back to
+    // its previous copy instead.
+    bool tryLoad(T& out) const {
+        uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        uint64_t buffer[WORDS];
+        for (size_t i = 0; i < WORDS; ++i) buffer[i] = words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before) return false;
+        std::memcpy(&out, buffer, sizeof(T));
+        return true;
+    }
+
+    // Retries until it gets a consistent copy. A write takes a few stores,
+    // so a reader only ever spins for the length of one.
+    T load() const {
+        T out;
+        while (!tryLoad(out)) {
+        }
+        return out;
+    }
+
+    // Number of completed writes.
+    uint64_t version() const { return sequence.load(std::memory_order_acquire) / 2; }
+};
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef SEQUENCER_H
+#define SEQUENCER_H
+
+// Lock-free ingress into the matching thread. Each gateway thread owns a pair
+// of SPSC rings: requests into the sequencer and responses back out. The
+// sequencer thread visits the gateways round-robin, takes up to `burst`
+// requests from each, stamps every one with a global sequence number, applies
+// it to the book and answers on that gateway's response ring. The book is only
+// ever touched by the sequencer thread, so it needs no lock.
+//
+// A gateway whose response ring is full is skipped until it reads its
+// responses, so a slow gateway cannot stall the others.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "exchange_orderbook.h"
+#include "spsc_ring.h"
+#include "symbol_engine.h"
+
+struct GatewayRequest {
+    uint64_t tag;          // caller's correlation ID, echoed in the response
+    SymbolCommand command; // symbol is ignored: one sequencer drives one book
+};
+
+struct GatewayResponse {
+    uint64_t tag;
+    uint64_t seq;     // global sequence number of the request
+    int32_t orderId;  // PLACE: the new order ID (-1 if rejected); CANCEL / MODIFY: the target
+    bool accepted;
+};
+
+struct SequencerConfig {
+    size_t ringCapacity = 4096; // per gateway, each direction
+    size_t burst = 64;          // requests taken from one gateway per visit
+};
+
+template <typename Book = OrderBook>
+class Sequencer {
+private:
+    struct Gateway {
+        SpscRing<GatewayRequest> requests;
+        SpscRing<GatewayResponse> responses;
+
+        explicit Gateway(size_t capacity) : requests(capacity), responses(capacity) {}
+    };
+
+    Book& book;
+    SequencerConfig config;
+    vector<unique_ptr<Gateway>> gateways;
+    uint64_t nextSeq = 1;                  // sequencer thread only
+    alignas(CACHE_LINE_SIZE) atomic<uint64_t> sequenced{0};
+    atomic<bool> running{false};
+    thread runner;
+
+    GatewayResponse apply(const GatewayRequest& request) {
+        const SymbolCommand& c = request.command;
+        GatewayResponse response{request.tag, nextSeq++, c.orderId, false};
+        switch (c.command) {
+            case CommandType::PLACE:
+                response.orderId = book.placeOrder(c.side == 0 ? "buy" : "sell", c.price, c.quantity,
+                                                   OrderType(c.orderType), c.clientId, c.stopPrice);
+                response.accepted = response.orderId > 0;
+                break;
+            case CommandType::CANCEL: response.accepted = book.cancelOrder(c.orderId); break;
+            case CommandType::MODIFY: response.accepted = book.modifyOrder(c.orderId, c.price, c.quantity); break;
+            default: OB_LOG_WARN("❌ Unsupported command %d from gateway", int(c.command));
+        }
+        return response;
+    }
+
+    // Up to `burst` requests from one gateway; each needs a free response slot.
+    size_t drain(Gateway& gateway) {
+        size_t done = 0;
+        while (done < config.burst) {
+            GatewayRequest* request = gateway.requests.peek();
+            if (!request) break;
+            GatewayResponse* response = gateway.responses.claim();
+            if (!response) break;
+            *response = apply(*request);
+            gateway.requests.release();
+            gateway.responses.publish();
+            ++done;
+        }
+        return done;
+    }
+
+    void run() {
+        size_t idlePolls = 0;
+        while (true) {
+            bool stop = !running.load(memory_order_acquire);
+            size_t done = 0;
+            for (auto& gateway : gateways) done += drain(*gateway);
+            if (done) {
+                sequenced.fetch_add(done, memory_order_release);
+                idlePolls = 0;
+            } else if (stop) {
+                break;
+            } else {
+                book.flushJournalIfDue();
+                if (++idlePolls < 1024) this_thread::yield();
+                else this_thread::sleep_for(chrono::microseconds(50));
+            }
+        }
+    }
+
+public:
+    // A gateway thread's end of its ring pair; use it from that one thread.
+    class GatewayHandle {
+    private:
+        Gateway* gateway;
+
+    public:
+        explicit GatewayHandle(Gateway* g) : gateway(g) {}
+
+        // False when the request ring is full.
+        bool submit(uint64_t tag, const SymbolCommand& command) {
+            return gateway->requests.try_push(GatewayRequest{tag, command});
+        }
+
+        // False when no response is waiting.
+        bool poll(GatewayResponse& out) { return gateway->responses.try_pop(out); }
+    };
+
+    explicit Sequencer(Book& book_, const SequencerConfig& config_ = {}) : book(book_), config(config_) {
+        if (config.burst == 0) config.burst = 1;
+    }
+
+    ~Sequencer() { stop(); }
+
+    Sequencer(const Sequencer&) = delete;
+    Sequencer& operator=(const Sequencer&) = delete;
+
+    // Gateways are added before start().
+    GatewayHandle addGateway() {
+        gateways.push_back(make_unique<Gateway>(config.ringCapacity));
+        return GatewayHandle(gateways.back().get());
+    }
+
+    void start() {
+        if (running.exchange(true)) return;
+        runner = thread([this] { run(); });
+    }
+
+    // Sequences whatever is already queued (as response space allows), then
+    // joins the sequencer thread. The book is safe to read afterwards.
+    void stop() {
+        if (!running.exchange(false)) return;
+        runner.join();
+    }
+
+    uint64_t sequencedCount() const { return sequenced.load(memory_order_acquire); }
+};
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef SNAPSHOT_FORMAT_H
+#define SNAPSHOT_FORMAT_H
+
+// Binary snapshot of the engine state. The file is a header followed by flat
+// arrays of fixed-size records, so loading is an mmap, two checksums and a walk
+// over the arrays; nothing is parsed.
+//
+//   SnapshotHeader
+//   SnapshotOrder[bidOrders]   resting bids, best level first, FIFO within a level
+//   SnapshotOrder[askOrders]   resting asks, same order
+//   SnapshotOrder[stopOrders]  pending stops, trigger order per side (buys first)
+//   SnapshotPosition[positions]
+//   char[stringBytes]          client IDs referenced by offset/length
+//
+// Prices and quantities are stored as ticks and lots, timestamps as ns since
+// the Unix epoch, so a reload keeps exact values and time priority.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+inline constexpr char SNAPSHOT_MAGIC[8] = {'O', 'B', 'S', 'N', 'A', 'P', '\0', '\0'};
+inline constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t orderRecordSize;
+    uint32_t positionRecordSize;
+    uint64_t journalSeq; // last journaled command the image includes (0 without a journal)
+    int64_t takenAt;     // ns since the Unix epoch
+    double minPrice;
+    double minQty;
+    double makerFee;
+    double takerFee;
+    int64_t orderCounter;
+    uint64_t bidOrders;
+    uint64_t askOrders;
+    uint64_t stopOrders;
+    uint64_t positions;
+    uint64_t stringBytes;
+    uint64_t payloadChecksum;
+    uint64_t headerChecksum; // of everything above
+};
+
+struct SnapshotOrder {
+    int64_t price;
+    int64_t quantity;
+    int64_t filledQty;
+    int64_t stopPrice;
+    int64_t timestamp;
+    int64_t latency;
+    uint32_t clientOffset;
+    uint32_t clientLength;
+    int32_t id;
+    uint8_t side; // 0 = buy, 1 = sell
+    uint8_t type;
+    uint8_t status;
+    uint8_t reserved;
+};
+
+struct SnapshotPosition {
+    uint32_t clientOffset;
+    uint32_t clientLength;
+    int64_t quantity;
+    double avgPrice;
+    double realizedPnl;
+    double feesPaid;
+    uint64_t fills;
+};
+
+static_assert(sizeof(SnapshotOrder) == 64);
+static_assert(sizeof(SnapshotPosition) == 48);
+
+// FNV-1a, one 64-bit word at a time (trailing bytes folded in singly).
+inline uint64_t snapshotChecksum(const unsigned char* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (; i < size; ++i) hash = (hash ^ data[i]) * 1099511628211ull;
+    return hash;
+}
+
+inline uint64_t headerChecksum(const SnapshotHeader& header) {
+    return snapshotChecksum(reinterpret_cast<const unsigned char*>(&header), offsetof(SnapshotHeader, headerChecksum));
+}
+
+// Assembles an image in memory. Orders and positions are appended in file
+// order; finish() lays out the sections and fills in the checksums.
+class SnapshotBuilder {
+private:
+    std::vector<SnapshotOrder> bids, asks, stops;
+    std::vector<SnapshotPosition> positions;
+    std::string strings;
+
+public:
+    SnapshotHeader header{};
+
+    void clear() {
+        bids.clear();
+        asks.clear();
+        stops.clear();
+        positions.clear();
+        strings.clear();
+        header = SnapshotHeader{};
+    }
+
+    void intern(std::string_view text, uint32_t& offset, uint32_t& length) {
+        offset = uint32_t(strings.size());
+        length = uint32_t(text.size());
+        strings.append(text);
+    }
+
+    void addBid(const SnapshotOrder& order) { bids.push_back(order); }
+    void addAsk(const SnapshotOrder& order) { asks.push_back(order); }
+    void addStop(const SnapshotOrder& order) { stops.push_back(order); }
+    void addPosition(const SnapshotPosition& position) { positions.push_back(position); }
+
+    void finish(std::vector<unsigned char>& out) {
+        std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.headerSize = sizeof(SnapshotHeader);
+        header.orderRecordSize = sizeof(SnapshotOrder);
+        header.positionRecordSize = sizeof(SnapshotPosition);
+        header.bidOrders = bids.size();
+        header.askOrders = asks.size();
+        header.stopOrders = stops.size();
+        header.positions = positions.size();
+        header.stringBytes = strings.size();
+
+        size_t payload = (bids.size() + asks.size() + stops.size()) * sizeof(SnapshotOrder) +
+                         positions.size() * sizeof(SnapshotPosition) + strings.size();
+        out.resize(sizeof(SnapshotHeader) + payload);
+        unsigned char* p = out.data() + sizeof(SnapshotHeader);
+        auto put = [&](const void* data, size_t bytes) {
+            if (bytes) std::memcpy(p, data, bytes);
+            p += bytes;
+        };
+        put(bids.data(), bids.size() * sizeof(SnapshotOrder));
+        put(asks.data(), asks.size() * sizeof(SnapshotOrder));
+        put(stops.data(), stops.size() * sizeof(SnapshotOrder));
+        put(positions.data(), positions.size() * sizeof(SnapshotPosition));
+        put(strings.data(), strings.size());
+
+        header.payloadChecksum = snapshotChecksum(out.data() + sizeof(SnapshotHeader), payload);
+        header.headerChecksum = headerChecksum(header);
+        std::memcpy(out.data(), &header, sizeof(header));
+    }
+};
+
+// Writes to path.tmp and renames over path, so readers never see a partial file.
+inline bool writeSnapshotFile(const std::string& path, const std::vector<unsigned char>& image) {
+    std::string tmp = path + ".tmp";
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    size_t done = 0;
+    while (done < image.size()) {
+        ssize_t n = ::write(fd, image.data() + done, image.size() - done);
+        if (n <= 0) {
+            ::close(fd);
+            ::unlink(tmp.c_str());
+            return false;
+        }
+        done += size_t(n);
+    }
+    bool ok = fdatasync(fd) == 0;
+    ok = ::close(fd) == 0 && ok;
+    return ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+// Read-only mapping of a snapshot file (or a view of an image in memory) with
+// the sections located. valid() is false when the file is missing, from
+// another version or fails a checksum.
+class SnapshotView {
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    bool ok = false;
+
+    void locate() {
+        if (!data || size < sizeof(SnapshotHeader)) return;
+        header = reinterpret_cast<const SnapshotHeader*>(data);
+        if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 ||
+            header->version != SNAPSHOT_VERSION || header->headerSize != sizeof(SnapshotHeader) ||
+            header->orderRecordSize != sizeof(SnapshotOrder) ||
+            header->positionRecordSize != sizeof(SnapshotPosition) || header->headerChecksum != headerChecksum(*header))
+            return;
+
+        size_t orders = header->bidOrders + header->askOrders + header->stopOrders;
+        size_t payload = orders * sizeof(SnapshotOrder) + header->positions * sizeof(SnapshotPosition) +
+                         header->stringBytes;
+        if (size != sizeof(SnapshotHeader) + payload ||
+            header->payloadChecksum != snapshotChecksum(data + sizeof(SnapshotHeader), payload))
+            return;
+
+        bids = reinterpret_cast<const SnapshotOrder*>(data + sizeof(SnapshotHeader));
+        asks = bids + header->bidOrders;
+        stops = asks + header->askOrders;
+        positions = reinterpret_cast<const SnapshotPosition*>(stops + header->stopOrders);
+        strings = reinterpret_cast<const char*>(positions + header->positions);
+        ok = true;
+    }
+
+public:
+    const SnapshotHeader* header = nullptr;
+    const SnapshotOrder* bids = nullptr;
+    const SnapshotOrder* asks = nullptr;
+    const SnapshotOrder* stops = nullptr;
+    const SnapshotPosition* positions = nullptr;
+    const char* strings = nullptr;
+
+    explicit SnapshotView(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(SnapshotHeader)) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                data = static_cast<const unsigned char*>(p);
+                size = st.st_size;
+                mapped = true;
+            }
+        }
+        ::close(fd);
+        locate();
+    }
+
+    // The image must outlive the view.
+    explicit SnapshotView(const std::vector<unsigned char>& image) : data(image.data()), size(image.size()) {
+        locate();
+    }
+
+    ~SnapshotView() {
+        if (mapped) munmap(const_cast<unsigned char*>(data), size);
+    }
+
+    SnapshotView(const SnapshotView&) = delete;
+    SnapshotView& operator=(const SnapshotView&) = delete;
+
+    bool valid() const { return ok; }
+
+    std::string_view string(uint32_t offset, uint32_t length) const {
+        if (uint64_t(offset) + length > header->stringBytes) return {};
+        return std::string_view(strings + offset, length);
+    }
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef SNAPSHOT_WRITER_H
+#define SNAPSHOT_WRITER_H
+
+// Background snapshots that never walk the live book. The writer keeps a
+// mirror: a second book on its own thread, fed through an SPSC ring the
+// record of every command the live book accepts (the records the journal
+// gets) and re-running them as journal replay does. A snapshot request is
+// one more entry in the ring; when the mirror reaches it, it holds exactly
+// the live state at the request, captures itself and writes the file
+// (fdatasync, then rename) while the live book keeps matching.
+//
+// The matching thread pays a record copy per command and a marker per
+// snapshot. It waits only when the mirror falls a whole ring behind, which
+// getStats() counts. The mirror starts from a capture of the live book when
+// the writer is attached or a snapshot is loaded, the only blocking copies.
+// Order latencies in the images are the mirror's own, not the live book's.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "async_logger.h"
+#include "command_journal.h"
+#include "snapshot_format.h"
+#include "spsc_ring.h"
+
+struct PoolConfig;
+
+struct SnapshotResult {
+    std::string path;
+    uint64_t journalSeq = 0; // replay the journal after this to catch up
+    bool ok = false;
+};
+
+struct SnapshotWriterStats {
+    uint64_t mirrored = 0;   // commands the mirror has applied
+    uint64_t queueWaits = 0; // times the matching thread found the ring full
+};
+
+// Book is the mirror's type, BasicOrderBook<...>::Mirror of the live book.
+template <typename Book>
+class SnapshotWriter {
+private:
+    enum class EntryKind : uint8_t { COMMAND, SNAPSHOT, SEED };
+
+    struct Entry {
+        EntryKind kind;
+        JournalRecord record; // SNAPSHOT: seq is the journal sequence it covers
+    };
+
+    Book mirror;
+    SpscRing<Entry> queue;
+    uint64_t queueWaits = 0; // matching thread
+    std::atomic<uint64_t> mirrored{0};
+    std::atomic<bool> stopping{false};
+
+    // Handed over under mutex while busy is false; the writer thread owns
+    // them until it clears busy again.
+    std::vector<unsigned char> image; // SEED: the state to start from; SNAPSHOT: capture buffer
+    std::string path;
+    bool busy = false;
+    uint64_t completed = 0;
+    SnapshotResult last;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread worker;
+
+    void push(EntryKind kind, const JournalRecord& record) {
+        Entry* slot = queue.claim();
+        if (!slot) {
+            queueWaits++;
+            do {
+                std::this_thread::yield();
+            } while (!(slot = queue.claim()));
+        }
+        slot->kind = kind;
+        slot->record = record;
+        queue.publish();
+    }
+
+    void finish(const SnapshotResult* result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (result) {
+            last = *result;
+            completed++;
+        }
+        busy = false;
+        cv.notify_all();
+    }
+
+    void writeSnapshot(uint64_t journalSeq) {
+        SnapshotResult result;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            result.path = path;
+        }
+        result.journalSeq = journalSeq;
+        mirror.captureSnapshot(image, journalSeq);
+        result.ok = writeSnapshotFile(result.path, image);
+        if (result.ok) {
+            OB_LOG_INFO("✅ Snapshot saved to %s (journal seq %llu)", result.path,
+                        (unsigned long long)result.journalSeq);
+        } else {
+            OB_LOG_ERROR("❌ Failed to save snapshot %s", result.path);
+        }
+        finish(&result);
+    }
+
+    void run() {
+        size_t idlePolls = 0;
+        while (true) {
+            bool stop = stopping.load(std::memory_order_acquire);
+            Entry* entry = queue.peek();
+            if (!entry) {
+                if (stop) break;
+                if (++idlePolls < 1024) std::this_thread::yield();
+                else std::this_thread::sleep_for(std::chrono::microseconds(50));
+                continue;
+            }
+            idlePolls = 0;
+            switch (entry->kind) {
+                case EntryKind::COMMAND: {
+                    oblog::ThreadMute mute; // the live book already logged it
+                    mirror.applyCommand(entry->record);
+                    mirrored.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                case EntryKind::SNAPSHOT: writeSnapshot(entry->record.seq); break;
+                case EntryKind::SEED: {
+                    bool ok;
+                    {
+                        oblog::ThreadMute mute;
+                        ok = mirror.loadSnapshotImage(image);
+                    }
+                    if (!ok) OB_LOG_ERROR("❌ Snapshot mirror could not load the live book's state");
+                    finish(nullptr);
+                    break;
+                }
+            }
+            queue.release();
+        }
+    }
+
+public:
+    // pools are the live book's; the mirror is built with Book::mirrorPools.
+    explicit SnapshotWriter(const PoolConfig& pools, size_t queueCapacity = 1 << 16)
+        : mirror(Book::mirrorPools(pools)), queue(queueCapacity), worker([this] { run(); }) {}
+
+    ~SnapshotWriter() {
+        stopping.store(true, std::memory_order_release);
+        worker.join(); // applies what is queued and finishes a write in progress first
+    }
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    // Matching thread: one command the live book accepted, in order.
+    void mirrorCommand(const JournalRecord& record) { push(EntryKind::COMMAND, record); }
+
+    // Matching thread: queues a snapshot of the state after every command
+    // mirrored so far. False if the previous snapshot is still pending.
+    bool requestSnapshot(const std::string& target, uint64_t journalSeq) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (busy) return false;
+            path = target;
+            busy = true;
+        }
+        JournalRecord marker{};
+        marker.seq = journalSeq;
+        push(EntryKind::SNAPSHOT, marker);
+        return true;
+    }
+
+    // Restarts the mirror from state, a captureSnapshot of the live book, and
+    // blocks until it has loaded it. state is left with an old buffer.
+    void seed(std::vector<unsigned char>& state) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return !busy; });
+            image.swap(state);
+            busy = true;
+        }
+        push(EntryKind::SEED, JournalRecord{});
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return !busy; });
+    }
+
+    bool idle() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !busy;
+    }
+
+    // Blocks until no snapshot is pending and returns the latest result.
+    SnapshotResult wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return !busy; });
+        return last;
+    }
+
+    // Result of the most recent completed write, and how many have completed.
+    SnapshotResult lastResult(uint64_t* count = nullptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count) *count = completed;
+        return last;
+    }
+
+    // Matching thread.
+    SnapshotWriterStats getStats() const {
+        return SnapshotWriterStats{mirrored.load(std::memory_order_relaxed), queueWaits};
+    }
+};
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+// Bounded single-producer / single-consumer ring. The producer and consumer
+// indices sit on separate cache lines, and each side keeps a cached copy of the
+// other's index, so an uncontended push or pop touches a shared line only when
+// the cached view runs out.
+//
+// Slots are written and read in place (claim/publish, peek/release) so large
+// records are not copied through the ring.
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+template <typename T>
+class SpscRing {
+private:
+    std::unique_ptr<T[]> slots;
+    size_t mask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0}; // next slot to write
+    size_t cachedHead = 0;                                // producer's view of head
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0}; // next slot to read
+    size_t cachedTail = 0;                                // consumer's view of tail
+
+public:
+    explicit SpscRing(size_t capacity = 1024)
+        : slots(new T[std::bit_ceil(std::max<size_t>(capacity, 2))]),
+          mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Producer: slot to fill, or nullptr when the ring is full.
+    T* claim() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead > mask) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead > mask) return nullptr;
+        }
+        return &slots[t & mask];
+    }
+
+    // Producer: makes the claimed slot visible to the consumer.
+    void publish() { tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    bool try_push(const T& value) {
+        T* slot = claim();
+        if (!slot) return false;
+        *slot = value;
+        publish();
+        return true;
+    }
+
+    // Consumer: oldest unread slot, or nullptr when empty.
+    T* peek() {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) return nullptr;
+        }
+        return &slots[h & mask];
+    }
+
+    // Consumer: hands the peeked slot back to the producer.
+    void release() { head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    bool try_pop(T& out) {
+        T* slot = peek();
+        if (!slot) return false;
+        out = std::move(*slot);
+        release();
+        return true;
+    }
+
+    // Approximate when called concurrently with the other side.
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif
@@ -0,0 +1,248 @@
+#ifndef SYMBOL_ENGINE_H
+#define SYMBOL_ENGINE_H
+
+// Multi-instrument front of the exchange engine. The registry owns one book per
+// symbol and shards symbols across worker threads (symbol ID modulo worker
+// count); each worker is optionally pinned to a core, builds its own books
+// there and is the only thread that ever touches them. Commands reach a worker
+// through its SPSC ring, so the routing thread and the workers share nothing
+// but the ring indices.
+//
+// Commands are submitted from a single routing thread (SPSC per worker), and
+// submit() returns no per-command result. Several gateway threads must funnel
+// into that one thread themselves: Sequencer drives a single book and does not
+// route into this engine.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "exchange_orderbook.h"
+#include "spsc_ring.h"
+
+using SymbolId = uint32_t;
+
+struct SymbolConfig {
+    string name;
+    double tickSize = 0.01;
+    double lotSize = 0.00001;
+    double makerFee = 0.001;
+    double takerFee = 0.002;
+    PoolConfig pools{};
+};
+
+struct EngineConfig {
+    size_t workers = 1;
+    vector<int> cores;          // worker i is pinned to cores[i % size]; empty: no pinning
+    size_t ringCapacity = 1 << 14;
+};
+
+// One command for one symbol, fixed-size so it travels through the rings as is.
+struct SymbolCommand {
+    SymbolId symbol;
+    CommandType command; // PLACE, CANCEL or MODIFY
+    uint8_t side;        // 0 = buy, 1 = sell
+    uint8_t orderType;
+    uint8_t reserved;
+    int32_t orderId;     // CANCEL / MODIFY target
+    uint32_t reserved1;
+    double price;
+    double quantity;
+    double stopPrice;
+    // One byte past the engine's limit, so an over-long ID arrives over-long
+    // and is rejected by the book instead of becoming a different client.
+    char clientId[MAX_CLIENT_ID_BYTES + 2];
+    char reserved2[86 - MAX_CLIENT_ID_BYTES];
+
+    static SymbolCommand place(SymbolId symbol, bool buy, double price, double quantity, OrderType type,
+                               string_view clientId = {}, double stopPrice = 0.0) {
+        SymbolCommand c{};
+        c.symbol = symbol;
+        c.command = CommandType::PLACE;
+        c.side = buy ? 0 : 1;
+        c.orderType = uint8_t(type);
+        c.price = price;
+        c.quantity = quantity;
+        c.stopPrice = stopPrice;
+        memcpy(c.clientId, clientId.data(), min(clientId.size(), MAX_CLIENT_ID_BYTES + 1));
+        return c;
+    }
+
+    static SymbolCommand cancel(SymbolId symbol, int orderId) {
+        SymbolCommand c{};
+        c.symbol = symbol;
+        c.command = CommandType::CANCEL;
+        c.orderId = orderId;
+        return c;
+    }
+
+    static SymbolCommand modify(SymbolId symbol, int orderId, double price, double quantity) {
+        SymbolCommand c{};
+        c.symbol = symbol;
+        c.command = CommandType::MODIFY;
+        c.orderId = orderId;
+        c.price = price;
+        c.quantity = quantity;
+        return c;
+    }
+};
+static_assert(sizeof(SymbolCommand) == 128);
+
+template <typename Book = OrderBook>
+class SymbolEngine {
+private:
+    struct Worker {
+        SpscRing<SymbolCommand> inbox;
+        vector<SymbolId> symbols;                       // owned, in ID order
+        unordered_map<SymbolId, unique_ptr<Book>> books; // built on the worker thread
+        thread runner;
+        alignas(CACHE_LINE_SIZE) atomic<uint64_t> processed{0};
+        alignas(CACHE_LINE_SIZE) uint64_t submitted = 0; // routing thread only
+
+        explicit Worker(size_t capacity) : inbox(capacity) {}
+    };
+
+    EngineConfig config;
+    vector<SymbolConfig> symbols;
+    unordered_map<string, SymbolId> byName;
+    vector<unique_ptr<Worker>> workers;
+    atomic<bool> running{false};
+
+    Worker& owner(SymbolId symbol) { return *workers[symbol % workers.size()]; }
+
+    static void pinToCore(int core) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            OB_LOG_WARN("⚠️ Could not pin worker to core %d", core);
+        }
+    }
+
+    static void apply(Book& book, const SymbolCommand& c) {
+        switch (c.command) {
+            case CommandType::PLACE:
+                book.placeOrder(c.side == 0 ? "buy" : "sell", c.price, c.quantity, OrderType(c.orderType),
+                                c.clientId, c.stopPrice);
+                break;
+            case CommandType::CANCEL: book.cancelOrder(c.orderId); break;
+            case CommandType::MODIFY: book.modifyOrder(c.orderId, c.price, c.quantity); break;
+            default: OB_LOG_WARN("❌ Unsupported command %d for symbol %u", int(c.command), c.symbol);
+        }
+    }
+
+    void run(Worker& worker, size_t index) {
+        if (!config.cores.empty()) pinToCore(config.cores[index % config.cores.size()]);
+        // Allocated after pinning so the books' memory is first touched here.
+        for (SymbolId id : worker.symbols) {
+            const SymbolConfig& cfg = symbols[id];
+            auto book = make_unique<Book>(cfg.pools);
+            book->setTickSize(cfg.tickSize, cfg.lotSize);
+            book->setFees(cfg.makerFee, cfg.takerFee);
+            worker.books.emplace(id, std::move(book));
+        }
+
+        size_t idlePolls = 0;
+        while (true) {
+            bool stop = !running.load(memory_order_acquire);
+            size_t done = 0;
+            while (SymbolCommand* c = worker.inbox.peek()) {
+                apply(*worker.books.at(c->symbol), *c);
+                worker.inbox.release();
+                ++done;
+            }
+            if (done) {
+                worker.processed.fetch_add(done, memory_order_release);
+                idlePolls = 0;
+            } else if (stop) {
+                break;
+            } else if (++idlePolls < 1024) {
+                this_thread::yield();
+            } else {
+                this_thread::sleep_for(chrono::microseconds(50));
+            }
+        }
+    }
+
+public:
+    explicit SymbolEngine(const EngineConfig& config_ = {}) : config(config_) {
+        if (config.workers == 0) config.workers = 1;
+    }
+
+    ~SymbolEngine() { stop(); }
+
+    SymbolEngine(const SymbolEngine&) = delete;
+    SymbolEngine& operator=(const SymbolEngine&) = delete;
+
+    // Symbols are registered before start(); IDs are dense from 0.
+    SymbolId addSymbol(const SymbolConfig& cfg) {
+        if (running.load()) {
+            OB_LOG_ERROR("❌ Cannot add symbol %s while the engine is running", cfg.name);
+            return UINT32_MAX;
+        }
+        auto [it, inserted] = byName.emplace(cfg.name, SymbolId(symbols.size()));
+        if (!inserted) return it->second;
+        symbols.push_back(cfg);
+        return it->second;
+    }
+
+    optional<SymbolId> findSymbol(const string& name) const {
+        auto it = byName.find(name);
+        return it == byName.end() ? nullopt : optional<SymbolId>{it->second};
+    }
+
+    const SymbolConfig& symbolConfig(SymbolId id) const { return symbols[id]; }
+    size_t symbolCount() const { return symbols.size(); }
+    size_t workerCount() const { return config.workers; }
+    size_t workerOf(SymbolId id) const { return id % config.workers; }
+
+    // Starts the workers; an engine is started once.
+    void start() {
+        if (!workers.empty() || running.exchange(true)) return;
+        for (size_t i = 0; i < config.workers; ++i) workers.push_back(make_unique<Worker>(config.ringCapacity));
+        for (SymbolId id = 0; id < symbols.size(); ++id) owner(id).symbols.push_back(id);
+        for (size_t i = 0; i < workers.size(); ++i) {
+            Worker& worker = *workers[i];
+            worker.runner = thread([this, &worker, i] { run(worker, i); });
+        }
+    }
+
+    // Finishes everything already submitted, then joins the workers. The books
+    // stay readable through book() afterwards.
+    void stop() {
+        if (!running.exchange(false)) return;
+        for (auto& worker : workers) worker->runner.join();
+    }
+
+    // Routes a command to its symbol's worker. Returns false for an unknown
+    // symbol or when that worker's ring is full (the caller retries or rejects).
+    bool submit(const SymbolCommand& command) {
+        if (command.symbol >= symbols.size() || workers.empty()) return false;
+        Worker& worker = owner(command.symbol);
+        if (!worker.inbox.try_push(command)) return false;
+        worker.submitted++;
+        return true;
+    }
+
+    // Blocks until every submitted command has been applied.
+    void drain() {
+        for (auto& worker : workers) {
+            while (worker->processed.load(memory_order_acquire) < worker->submitted) this_thread::yield();
+        }
+    }
+
+    // Only while the engine is stopped (or from the owning worker).
+    Book& book(SymbolId id) { return *owner(id).books.at(id); }
+};
+
+#endif
@@ -0,0 +1,362 @@
+// test_engine.cpp
+// Behavior checks for the engine paths the benchmarks exercise only for speed.
+// Prints each failed check and exits non-zero if any failed.
+//   g++ -std=c++20 -O2 -DOB_LOG_LEVEL=OB_LEVEL_OFF test_engine.cpp -o test_engine -pthread
+
+#include "exchange_orderbook.h"
+#include "symbol_engine.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <random>
+
+static int failures = 0;
+
+#define CHECK(cond, ...)                                  \
+    do {                                                  \
+        if (!(cond)) {                                    \
+            failures++;                                   \
+            oblog::flush();                               \
+            printf("FAIL %s:%d: %s | ", __func__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                          \
+            printf("\n");                                 \
+        }                                                 \
+    } while (0)
+
+vector<StoredTrade> tradesOf(OrderBook& ob) {
+    vector<StoredTrade> out;
+    ob.forEachTrade([&](const Trade& t) { out.push_back({0, t.price, t.quantity, t.buyOrderId, t.sellOrderId, t.fee}); });
+    return out;
+}
+
+// Trades must match in order, ignoring timestamps.
+void checkSameTrades(OrderBook& a, OrderBook& b, const char* what) {
+    vector<StoredTrade> ta = tradesOf(a), tb = tradesOf(b);
+    CHECK(ta.size() == tb.size(), "%s: %zu vs %zu trades", what, ta.size(), tb.size());
+    for (size_t i = 0; i < min(ta.size(), tb.size()); ++i) {
+        const StoredTrade& x = ta[i];
+        const StoredTrade& y = tb[i];
+        bool same = x.price == y.price && x.quantity == y.quantity && x.buyOrderId == y.buyOrderId &&
+                    x.sellOrderId == y.sellOrderId && fabs(x.fee - y.fee) < 1e-9;
+        CHECK(same, "%s: trade %zu differs (%lld @ %lld, %d/%d vs %lld @ %lld, %d/%d)", what, i, (long long)x.quantity,
+              (long long)x.price, x.buyOrderId, x.sellOrderId, (long long)y.quantity, (long long)y.price, y.buyOrderId,
+              y.sellOrderId);
+        if (!same) return;
+    }
+}
+
+void checkSamePositions(OrderBook& a, OrderBook& b, const vector<string>& clients, const char* what) {
+    for (const string& client : clients) {
+        optional<PositionReport> pa = a.getPosition(client), pb = b.getPosition(client);
+        CHECK(pa.has_value() == pb.has_value(), "%s: %s has a position in only one book", what, client.c_str());
+        if (!pa || !pb) continue;
+        CHECK(fabs(pa->quantity - pb->quantity) < 1e-9 && fabs(pa->realizedPnl - pb->realizedPnl) < 1e-6 &&
+                  fabs(pa->feesPaid - pb->feesPaid) < 1e-9,
+              "%s: %s position differs", what, client.c_str());
+    }
+}
+
+// Resting orders must match side by side: same IDs, prices and open
+// quantities in the same priority order.
+void checkSameResting(OrderBook& a, OrderBook& b, const char* what) {
+    for (const char* side : {"buy", "sell"}) {
+        vector<tuple<int, Ticks, Lots>> ra, rb;
+        a.forEachRestingOrder(side, [&](int id, Ticks price, Lots open) { ra.emplace_back(id, price, open); return true; });
+        b.forEachRestingOrder(side, [&](int id, Ticks price, Lots open) { rb.emplace_back(id, price, open); return true; });
+        CHECK(ra == rb, "%s: resting %s orders differ (%zu vs %zu)", what, side, ra.size(), rb.size());
+    }
+}
+
+OrderBook newBook(size_t capacity = 1 << 12) {
+    return OrderBook(PoolConfig{.orderCapacity = capacity, .tradeCapacity = capacity});
+}
+
+// An order in a placeOrders burst that crosses an earlier one from the same
+// burst takes at the resting price, as it would placed on its own.
+void testBurstCrossMatchesSingleOrders() {
+    vector<OrderRequest> flow = {{"sell", 100.00, 1.0, LIMIT, "Seller"}, {"buy", 101.00, 1.0, LIMIT, "Buyer"}};
+    OrderBook single = newBook(), batched = newBook();
+    single.setTickSize(0.01, 0.001);
+    batched.setTickSize(0.01, 0.001);
+    for (const OrderRequest& r : flow) single.placeOrder(r.side, r.price, r.quantity, r.type, r.clientId);
+    vector<int> ids(flow.size());
+    batched.placeOrders(flow, ids);
+
+    vector<StoredTrade> trades = tradesOf(batched);
+    CHECK(trades.size() == 1 && trades[0].price == 10000, "burst cross traded at %lld",
+          trades.empty() ? 0LL : (long long)trades[0].price);
+    checkSameTrades(single, batched, "burst cross");
+    checkSamePositions(single, batched, {"Seller", "Buyer"}, "burst cross");
+}
+
+// Random limit, IOC and market flow: bursts give the same trades, IDs and
+// positions as the same requests one by one. (Stops are left out: a burst
+// triggers them once at its end by design.)
+void testBurstsMatchSingleOrders() {
+    mt19937_64 rng(15);
+    vector<string> clients = {"A", "B", "C", "D"};
+    vector<OrderRequest> flow;
+    for (int i = 0; i < 20000; ++i) {
+        bool buy = rng() & 1;
+        double price = 100.00 + double(int64_t(rng() % 20) - 10) * 0.01;
+        double qty = double(1 + rng() % 50) * 0.001;
+        uint64_t kind = rng() % 10;
+        OrderType type = kind == 0 ? MARKET : kind == 1 ? IOC : kind == 2 ? FOK : LIMIT;
+        flow.push_back({buy ? "buy" : "sell", type == MARKET ? 0.0 : price, qty, type, clients[rng() % clients.size()]});
+    }
+
+    OrderBook single = newBook(1 << 15), batched = newBook(1 << 15);
+    single.setTickSize(0.01, 0.001);
+    batched.setTickSize(0.01, 0.001);
+    vector<int> singleIds(flow.size()), batchedIds(flow.size());
+    for (size_t i = 0; i < flow.size(); ++i) {
+        const OrderRequest& r = flow[i];
+        singleIds[i] = single.placeOrder(r.side, r.price, r.quantity, r.type, r.clientId);
+    }
+    span<const OrderRequest> requests(flow);
+    for (size_t i = 0; i < flow.size(); i += 64) {
+        size_t n = min<size_t>(64, flow.size() - i);
+        batched.placeOrders(requests.subspan(i, n), span<int>(batchedIds).subspan(i, n));
+    }
+    CHECK(singleIds == batchedIds, "order IDs differ");
+    checkSameTrades(single, batched, "random bursts");
+    checkSamePositions(single, batched, clients, "random bursts");
+}
+
+// On a limit cross the resting order's client pays the fee, at the maker
+// rate, whichever side it is on; the aggressor pays nothing.
+void testLimitCrossChargesMaker() {
+    for (bool buyerAggresses : {true, false}) {
+        OrderBook ob = newBook();
+        ob.setTickSize(0.01, 0.001);
+        ob.setFees(0.001, 0.002);
+        const char* resting = buyerAggresses ? "sell" : "buy";
+        const char* aggressing = buyerAggresses ? "buy" : "sell";
+        ob.placeOrder(resting, 100.00, 1.0, LIMIT, "Maker");
+        ob.placeOrder(aggressing, 100.00, 1.0, LIMIT, "Taker");
+        optional<PositionReport> maker = ob.getPosition("Maker"), taker = ob.getPosition("Taker");
+        CHECK(maker && taker, "%s aggressor: missing position", aggressing);
+        if (!maker || !taker) continue;
+        CHECK(fabs(maker->feesPaid - 0.1) < 1e-9, "%s aggressor: resting side paid %f, expected 0.1", aggressing,
+              maker->feesPaid);
+        CHECK(taker->feesPaid == 0.0, "%s aggressor: aggressor paid %f", aggressing, taker->feesPaid);
+    }
+}
+
+// Loading a snapshot replaces the book's history: orders finished after it
+// was taken are no longer found, and the emptied book accepts a new tick size.
+void testLoadSnapshotForgetsArchive() {
+    const char* path = "test_engine.snapshot";
+    OrderBook ob = newBook();
+    ob.setTickSize(0.01, 0.001);
+    int resting = ob.placeOrder("buy", 100.00, 1.0, LIMIT, "A");
+    CHECK(ob.saveSnapshot(path), "snapshot not saved");
+    int finished = ob.placeOrder("buy", 99.00, 1.0, LIMIT, "B");
+    ob.cancelOrder(finished);
+    ob.placeOrder("buy", 98.00, 1.0, LIMIT, "C");
+    ArchivedOrder rec;
+    CHECK(ob.findOrderRecord(finished, rec), "cancelled order %d not archived", finished);
+
+    CHECK(ob.loadSnapshot(path), "snapshot not loaded");
+    CHECK(!ob.findOrderRecord(finished, rec), "order %d placed after the snapshot still found", finished);
+    CHECK(ob.findOrderRecord(resting, rec) && rec.status == OPEN, "resting order %d lost", resting);
+    CHECK(ob.getArchiveStats().archived == 0, "archive holds %llu records after load",
+          (unsigned long long)ob.getArchiveStats().archived);
+
+    OrderBook empty = newBook();
+    empty.setTickSize(0.01, 0.001);
+    CHECK(empty.saveSnapshot(path), "empty snapshot not saved");
+    empty.cancelOrder(empty.placeOrder("buy", 100.00, 1.0, LIMIT, "A"));
+    empty.placeOrder("sell", 0.0, 1.0, MARKET, "B");
+    CHECK(empty.loadSnapshot(path), "empty snapshot not loaded");
+    CHECK(empty.setTickSize(0.05, 0.01), "tick size refused after loading an empty book");
+    remove(path);
+}
+
+// Client IDs up to MAX_CLIENT_ID_BYTES are taken whole; longer ones are
+// rejected on every entry path instead of being truncated.
+void testLongClientIdRejected() {
+    OrderBook ob = newBook();
+    ob.setTickSize(0.01, 0.001);
+    string longest(MAX_CLIENT_ID_BYTES, 'x'), tooLong(MAX_CLIENT_ID_BYTES + 1, 'x');
+    CHECK(ob.placeOrder("buy", 100.00, 1.0, LIMIT, longest) > 0, "%zu-byte client ID refused", longest.size());
+    CHECK(ob.placeOrder("buy", 100.00, 1.0, LIMIT, tooLong) < 0, "%zu-byte client ID accepted", tooLong.size());
+    vector<OrderRequest> burst = {{"buy", 100.00, 1.0, LIMIT, tooLong}, {"buy", 100.00, 1.0, LIMIT, longest}};
+    vector<int> ids(burst.size());
+    ob.placeOrders(burst, ids);
+    CHECK(ids[0] < 0 && ids[1] > 0, "burst: IDs %d, %d", ids[0], ids[1]);
+    SymbolCommand c = SymbolCommand::place(0, true, 100.00, 1.0, LIMIT, string(200, 'x'));
+    CHECK(strlen(c.clientId) > MAX_CLIENT_ID_BYTES, "SymbolCommand cut the client ID to %zu bytes", strlen(c.clientId));
+}
+
+// Spilled trades stay queryable while and after they are written, and a store
+// that is cleared, or another store in the same directory, never replaces
+// files written earlier.
+void testSpillFilesNeverReplaced() {
+    const char* dir = "test_engine_spill";
+    filesystem::remove_all(dir);
+    filesystem::create_directories(dir);
+    auto fill = [](TradeStore& store, int64_t first) {
+        for (int64_t i = 0; i < 20; ++i) store.push_back({first + i, 100, first + i, 1, 2, 0.0});
+    };
+    auto quantities = [](TradeStore& store) {
+        vector<int64_t> out;
+        store.forEach([&](const StoredTrade& t) { out.push_back(t.quantity); });
+        return out;
+    };
+    vector<int64_t> expected(20);
+    {
+        TradeStore a(4, OverflowPolicy::GROW, dir, 2), b(4, OverflowPolicy::GROW, dir, 2);
+        fill(a, 0);
+        iota(expected.begin(), expected.end(), 0);
+        CHECK(quantities(a) == expected, "first run: %zu trades queryable", quantities(a).size());
+        a.clear();
+        fill(a, 100);
+        fill(b, 200);
+        iota(expected.begin(), expected.end(), 100);
+        CHECK(quantities(a) == expected, "after clear: %zu trades queryable", quantities(a).size());
+        iota(expected.begin(), expected.end(), 200);
+        CHECK(quantities(b) == expected, "second store: %zu trades queryable", quantities(b).size());
+    }
+    // Each run of 20 trades spills 8 of its 10 chunks; the last 2 stay in memory.
+    size_t files = distance(filesystem::directory_iterator(dir), filesystem::directory_iterator());
+    CHECK(files == 24, "%zu spill files, expected 24", files);
+    filesystem::remove_all(dir);
+}
+
+const vector<string> SESSION_CLIENTS = {"A", "B", "C", "D"};
+
+// count random commands: single orders of every type, bursts, cancels (single
+// and batched) and modifies, around 100.00. ids collects the placed orders.
+void runRandomSession(OrderBook& ob, mt19937_64& rng, vector<int>& ids, int count) {
+    auto randomRequest = [&]() -> OrderRequest {
+        bool buy = rng() & 1;
+        double price = 100.00 + double(int64_t(rng() % 20) - 10) * 0.01;
+        double qty = double(1 + rng() % 50) * 0.001;
+        uint64_t kind = rng() % 12;
+        OrderType type = kind == 0 ? MARKET : kind == 1 ? IOC : kind == 2 ? FOK : kind == 3 ? STOP : LIMIT;
+        return {buy ? "buy" : "sell", type == MARKET || type == STOP ? 0.0 : price, qty, type,
+                SESSION_CLIENTS[rng() % SESSION_CLIENTS.size()], type == STOP ? price : 0.0};
+    };
+    for (int i = 0; i < count; ++i) {
+        uint64_t action = rng() % 10;
+        if (action == 0 && !ids.empty()) {
+            ob.cancelOrder(ids[rng() % ids.size()]);
+        } else if (action == 1 && !ids.empty()) {
+            int id = ids[rng() % ids.size()];
+            ob.modifyOrder(id, 100.00 + double(int64_t(rng() % 20) - 10) * 0.01, double(1 + rng() % 50) * 0.001);
+        } else if (action == 2) {
+            vector<OrderRequest> burst;
+            for (int j = 0; j < 16; ++j) burst.push_back(randomRequest());
+            vector<int> burstIds(burst.size());
+            ob.placeOrders(burst, burstIds);
+            for (int id : burstIds) if (id >= 0) ids.push_back(id);
+        } else if (action == 3 && !ids.empty()) {
+            vector<int> cancel;
+            for (int j = 0; j < 8; ++j) cancel.push_back(ids[rng() % ids.size()]);
+            bool cancelled[8];
+            ob.cancelOrders(cancel, span<bool>(cancelled, cancel.size()));
+        } else {
+            OrderRequest r = randomRequest();
+            int id = ob.placeOrder(r.side, r.price, r.quantity, r.type, r.clientId, r.stopPrice);
+            if (id >= 0) ids.push_back(id);
+        }
+    }
+}
+
+// A journaled session of single orders, bursts, cancels, modifies, stops and
+// a fee change replays into a fresh book with the same IDs, trades, positions
+// and resting orders.
+void testJournalReplayMatchesLiveBook() {
+    const char* path = "test_engine.journal";
+    remove(path);
+    mt19937_64 rng(17);
+    const vector<string>& clients = SESSION_CLIENTS;
+
+    OrderBook live = newBook(1 << 15);
+    vector<int> ids;
+    {
+        CommandJournal journal(path);
+        live.attachJournal(&journal);
+        live.setTickSize(0.01, 0.001);
+        live.setFees(0.0001, 0.0005);
+        runRandomSession(live, rng, ids, 2501);
+        live.setFees(0.0002, 0.0004);
+        runRandomSession(live, rng, ids, 2499);
+        live.attachJournal(nullptr);
+        journal.sync();
+        CHECK(journal.durableSeq() == journal.lastSeq(), "durable seq %llu after sync, last %llu",
+              (unsigned long long)journal.durableSeq(), (unsigned long long)journal.lastSeq());
+    }
+
+    OrderBook replayed = newBook(1 << 15);
+    uint64_t applied = replayed.replayJournal(path);
+    remove(path);
+    CHECK(applied > 5000, "replayed only %llu commands", (unsigned long long)applied);
+    CHECK(replayed.placeOrder("buy", 99.00, 0.001, LIMIT, "A") == live.placeOrder("buy", 99.00, 0.001, LIMIT, "A"),
+          "next order ID differs after replay");
+    checkSameTrades(live, replayed, "journal replay");
+    checkSamePositions(live, replayed, clients, "journal replay");
+    checkSameResting(live, replayed, "journal replay");
+}
+
+// Snapshots taken through a SnapshotWriter hold the state at the request, not
+// at the write: they load into the same book as a synchronous snapshot taken
+// at that point, with the writer attached mid-session and after a load.
+void testAsyncSnapshotMatchesSync() {
+    const char* syncPath = "test_engine_sync.snapshot";
+    const char* asyncPath = "test_engine_async.snapshot";
+    PoolConfig pools{.orderCapacity = 1 << 15, .tradeCapacity = 1 << 15};
+    mt19937_64 rng(29);
+    vector<int> ids;
+    OrderBook live(pools);
+    SnapshotWriter<OrderBook::Mirror> writer(pools, 64); // small ring: the matching thread has to wait for it
+    live.setTickSize(0.01, 0.001);
+    runRandomSession(live, rng, ids, 500);
+    live.attachSnapshotWriter(&writer);
+
+    auto compare = [&](const char* what) {
+        CHECK(live.saveSnapshot(syncPath), "%s: snapshot not saved", what);
+        optional<uint64_t> requested = live.saveSnapshotAsync(asyncPath);
+        CHECK(requested.has_value(), "%s: async snapshot refused", what);
+        runRandomSession(live, rng, ids, 500);
+        CHECK(writer.wait().ok, "%s: async snapshot not written", what);
+        OrderBook fromSync(pools), fromAsync(pools);
+        CHECK(fromSync.loadSnapshot(syncPath) && fromAsync.loadSnapshot(asyncPath), "%s: snapshots not loaded", what);
+        CHECK(fromSync.placeOrder("buy", 99.00, 0.001, LIMIT, "A") == fromAsync.placeOrder("buy", 99.00, 0.001, LIMIT, "A"),
+              "%s: next order ID differs", what);
+        checkSamePositions(fromSync, fromAsync, SESSION_CLIENTS, what);
+        checkSameResting(fromSync, fromAsync, what);
+    };
+
+    runRandomSession(live, rng, ids, 2000);
+    compare("attached mid-session");
+    live.setFees(0.0002, 0.0004);
+    runRandomSession(live, rng, ids, 1000);
+    compare("after a fee change");
+    CHECK(live.loadSnapshot(syncPath), "snapshot not reloaded");
+    runRandomSession(live, rng, ids, 1000);
+    compare("after a load");
+    CHECK(writer.getStats().queueWaits > 0, "ring never filled; the test does not cover waiting");
+    live.attachSnapshotWriter(nullptr);
+    remove(syncPath);
+    remove(asyncPath);
+}
+
+int main() {
+    testBurstCrossMatchesSingleOrders();
+    testBurstsMatchSingleOrders();
+    testLimitCrossChargesMaker();
+    testLoadSnapshotForgetsArchive();
+    testLongClientIdRejected();
+    testSpillFilesNeverReplaced();
+    testJournalReplayMatchesLiveBook();
+    testAsyncSnapshotMatchesSync();
+    oblog::flush();
+    if (failures) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All engine tests passed\n");
+    return 0;
+}
@@ -0,0 +1,268 @@
+#ifndef TRADE_ANALYTICS_H
+#define TRADE_ANALYTICS_H
+
+// OHLCV bars, session VWAP and rolling volume kept current trade by trade, so
+// nothing has to reprocess the trade history to chart the market.
+//
+// onTrade() is O(1): every bar interval updates its open bar and closes it
+// when a trade lands in a later interval; every rolling window is a ring of
+// fixed-width buckets with running sums, and buckets that age out are
+// subtracted as time moves on. Bars are aligned to multiples of their
+// interval since the epoch (1m bars start on the minute, UTC). A bar with no
+// trades is never produced.
+//
+// The matching thread owns the analytics (the engine feeds it, see
+// attachAnalytics). Other threads read:
+//   - read() / tryRead(): an AnalyticsSnapshot through a SeqLock, refreshed
+//     by publish(), which the engine calls once per command;
+//   - pollBar(): every completed bar in order, through an SPSC ring to one
+//     consumer such as a charting thread. A bar that finds the ring full is
+//     dropped and counted.
+// Prices are ticks, quantities lots, times ns since the Unix epoch and
+// notional ticks x lots.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "seqlock.h"
+#include "spsc_ring.h"
+
+inline constexpr size_t MAX_BAR_INTERVALS = 4;
+inline constexpr size_t MAX_ROLLING_WINDOWS = 4;
+
+struct Bar {
+    int64_t start; // interval start
+    int64_t open;
+    int64_t high;
+    int64_t low;
+    int64_t close;
+    int64_t volume;
+    int64_t notional;
+    uint32_t trades;  // 0: no bar open
+    uint8_t interval; // index into AnalyticsConfig::barIntervals
+    uint8_t reserved[3];
+
+    double vwap() const { return volume ? double(notional) / double(volume) : 0.0; }
+};
+static_assert(sizeof(Bar) == 64);
+
+struct RollingWindow {
+    int64_t length; // ns, rounded up to whole buckets
+    int64_t end;    // the window covers [end - length, end)
+    int64_t volume;
+    int64_t notional;
+    uint64_t trades;
+
+    double vwap() const { return volume ? double(notional) / double(volume) : 0.0; }
+};
+
+struct AnalyticsSnapshot {
+    // Session so far (since construction or clear()).
+    uint64_t trades;
+    int64_t lastTime;
+    int64_t open;
+    int64_t high;
+    int64_t low;
+    int64_t last;
+    int64_t volume;
+    int64_t notional;
+
+    uint32_t barIntervals;
+    uint32_t rollingWindows;
+    Bar current[MAX_BAR_INTERVALS];  // bar still open per interval
+    Bar previous[MAX_BAR_INTERVALS]; // last completed per interval
+    RollingWindow rolling[MAX_ROLLING_WINDOWS];
+
+    double vwap() const { return volume ? double(notional) / double(volume) : 0.0; }
+};
+
+struct AnalyticsConfig {
+    // Up to MAX_BAR_INTERVALS / MAX_ROLLING_WINDOWS entries; the rest and
+    // non-positive lengths are ignored.
+    std::vector<std::chrono::nanoseconds> barIntervals = {std::chrono::seconds(1), std::chrono::minutes(1),
+                                                          std::chrono::minutes(5)};
+    std::vector<std::chrono::nanoseconds> rollingWindows = {std::chrono::minutes(1), std::chrono::minutes(5)};
+    size_t bucketsPerWindow = 60; // rolling windows move in steps of length / buckets
+    size_t barRingCapacity = 1 << 12;
+};
+
+struct AnalyticsStats {
+    uint64_t trades = 0;
+    uint64_t lateTrades = 0; // older than a rolling window's oldest bucket, left out of it
+    uint64_t barsCompleted = 0;
+    uint64_t barsDropped = 0; // completed bars that found the ring full
+    uint64_t published = 0;
+};
+
+class TradeAnalytics {
+private:
+    struct Bucket {
+        int64_t volume = 0;
+        int64_t notional = 0;
+        uint64_t trades = 0;
+    };
+
+    struct Window {
+        int64_t width;     // bucket width, ns
+        int64_t head = -1; // newest bucket number (time / width); -1 before any
+        std::vector<Bucket> buckets;
+    };
+
+    std::vector<int64_t> intervals;
+    std::vector<Window> windows;
+    AnalyticsSnapshot state{}; // matching thread's working copy
+    SeqLock<AnalyticsSnapshot> snapshot;
+    SpscRing<Bar> completed;
+    AnalyticsStats stats;
+    bool dirty = false;
+
+    void closeBar(size_t i) {
+        Bar& bar = state.current[i];
+        state.previous[i] = bar;
+        stats.barsCompleted++;
+        if (!completed.try_push(bar)) stats.barsDropped++;
+        bar = Bar{};
+        dirty = true;
+    }
+
+    void addToBar(size_t i, int64_t time, int64_t price, int64_t qty) {
+        Bar& bar = state.current[i];
+        int64_t interval = intervals[i];
+        if (bar.trades && time >= bar.start + interval) closeBar(i);
+        if (!bar.trades) {
+            bar.start = time - time % interval;
+            bar.open = bar.high = bar.low = price;
+            bar.interval = uint8_t(i);
+        }
+        // A trade stamped before the open bar (clock stepped back) joins it.
+        bar.high = std::max(bar.high, price);
+        bar.low = std::min(bar.low, price);
+        bar.close = price;
+        bar.volume += qty;
+        bar.notional += price * qty;
+        bar.trades++;
+    }
+
+    // Moves the window's newest bucket up to `bucket`, expiring the ones that
+    // fall out. Each bucket is expired once, however far time jumps.
+    void advanceWindow(size_t i, int64_t bucket) {
+        Window& w = windows[i];
+        if (bucket <= w.head) return;
+        RollingWindow& r = state.rolling[i];
+        int64_t n = int64_t(w.buckets.size());
+        if (w.head < 0 || bucket - w.head >= n) {
+            std::fill(w.buckets.begin(), w.buckets.end(), Bucket{});
+            r.volume = r.notional = 0;
+            r.trades = 0;
+        } else {
+            for (int64_t k = w.head + 1; k <= bucket; ++k) {
+                Bucket& b = w.buckets[size_t(k % n)];
+                r.volume -= b.volume;
+                r.notional -= b.notional;
+                r.trades -= b.trades;
+                b = Bucket{};
+            }
+        }
+        w.head = bucket;
+        r.end = (bucket + 1) * w.width;
+        dirty = true;
+    }
+
+    void addToWindow(size_t i, int64_t time, int64_t price, int64_t qty) {
+        Window& w = windows[i];
+        int64_t bucket = time / w.width;
+        advanceWindow(i, bucket);
+        if (bucket <= w.head - int64_t(w.buckets.size())) {
+            stats.lateTrades++;
+            return;
+        }
+        Bucket& b = w.buckets[size_t(bucket % int64_t(w.buckets.size()))];
+        RollingWindow& r = state.rolling[i];
+        b.volume += qty;
+        b.notional += price * qty;
+        b.trades++;
+        r.volume += qty;
+        r.notional += price * qty;
+        r.trades++;
+    }
+
+public:
+    explicit TradeAnalytics(const AnalyticsConfig& config = {}) : completed(config.barRingCapacity) {
+        for (std::chrono::nanoseconds interval : config.barIntervals) {
+            if (interval.count() > 0 && intervals.size() < MAX_BAR_INTERVALS) intervals.push_back(interval.count());
+        }
+        size_t buckets = std::max<size_t>(config.bucketsPerWindow, 1);
+        for (std::chrono::nanoseconds length : config.rollingWindows) {
+            if (length.count() <= 0 || windows.size() == MAX_ROLLING_WINDOWS) continue;
+            int64_t width = (length.count() + int64_t(buckets) - 1) / int64_t(buckets);
+            windows.push_back(Window{width, -1, std::vector<Bucket>(buckets)});
+        }
+        clear();
+    }
+
+    TradeAnalytics(const TradeAnalytics&) = delete;
+    TradeAnalytics& operator=(const TradeAnalytics&) = delete;
+
+    // Matching thread only.
+    void onTrade(int64_t time, int64_t price, int64_t qty) {
+        if (state.trades == 0) state.open = state.high = state.low = price;
+        state.trades++;
+        state.lastTime = time;
+        state.high = std::max(state.high, price);
+        state.low = std::min(state.low, price);
+        state.last = price;
+        state.volume += qty;
+        state.notional += price * qty;
+        for (size_t i = 0; i < intervals.size(); ++i) addToBar(i, time, price, qty);
+        for (size_t i = 0; i < windows.size(); ++i) addToWindow(i, time, price, qty);
+        stats.trades++;
+        dirty = true;
+    }
+
+    // Lets time pass without trades: closes bars whose interval has ended and
+    // ages the rolling windows. Matching thread only.
+    void advanceTo(int64_t now) {
+        for (size_t i = 0; i < intervals.size(); ++i) {
+            if (state.current[i].trades && now >= state.current[i].start + intervals[i]) closeBar(i);
+        }
+        for (size_t i = 0; i < windows.size(); ++i) advanceWindow(i, now / windows[i].width);
+    }
+
+    // Advances to `now` and makes the state visible to readers if it changed.
+    void publish(int64_t now) {
+        advanceTo(now);
+        if (!dirty) return;
+        snapshot.store(state);
+        stats.published++;
+        dirty = false;
+    }
+
+    // Starts a new session: totals, bars and windows restart empty. Completed
+    // bars already in the ring stay there.
+    void clear() {
+        state = AnalyticsSnapshot{};
+        state.barIntervals = uint32_t(intervals.size());
+        state.rollingWindows = uint32_t(windows.size());
+        for (size_t i = 0; i < windows.size(); ++i) {
+            Window& w = windows[i];
+            w.head = -1;
+            std::fill(w.buckets.begin(), w.buckets.end(), Bucket{});
+            state.rolling[i].length = w.width * int64_t(w.buckets.size());
+        }
+        snapshot.store(state);
+        dirty = false;
+    }
+
+    // Any thread: the state as of the last publish().
+    AnalyticsSnapshot read() const { return snapshot.load(); }
+    bool tryRead(AnalyticsSnapshot& out) const { return snapshot.tryLoad(out); }
+
+    // The one bar consumer thread.
+    bool pollBar(Bar& out) { return completed.try_pop(out); }
+
+    const AnalyticsStats& getStats() const { return stats; }
+};
+
+#endif
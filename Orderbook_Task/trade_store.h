@@ -0,0 +1,422 @@
+#ifndef TRADE_STORE_H
+#define TRADE_STORE_H
+
+// Bounded trade history. Trades are appended into fixed-size chunks held as
+// columns (timestamp, price, quantity, buy ID, sell ID, fee), so a query
+// filtering on one field streams through that column alone. Each chunk keeps
+// its time and order-ID range, and queries skip chunks that cannot match.
+//
+// Memory holds `capacity` trades (rounded up to whole chunks), all allocated
+// up front. When it is full the oldest chunk makes room for the next one:
+//   - with a spill directory, the chunk goes to a background writer thread,
+//     which writes it to <dir>/trades-<session>-<first trade index>.col while
+//     matching continues; it stays queryable in memory until written, then
+//     from the file. One extra chunk is allocated for the write in flight, so
+//     the matching thread only waits if the disk falls a whole chunk behind;
+//   - otherwise the OverflowPolicy decides: GROW adds a chunk, OVERWRITE drops
+//     the oldest one, REJECT stops recording.
+// Spill files are not removed by the store; they are the day's archive. The
+// session is the time the store was created or cleared, and files are created
+// exclusively (a clash takes the next free name), so a restart, a clear() or
+// another book sharing the directory never overwrites earlier history.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "async_logger.h"
+#include "object_pool.h"
+
+struct StoredTrade {
+    int64_t timestamp; // ns since the Unix epoch
+    int64_t price;     // ticks
+    int64_t quantity;  // lots
+    int32_t buyOrderId;
+    int32_t sellOrderId;
+    double fee;
+};
+
+struct TradeStoreStats {
+    uint64_t recorded = 0; // every trade appended since construction / clear()
+    uint64_t spilled = 0;  // trades written out to spill files
+    uint64_t spillFailures = 0;
+    uint64_t spillWaits = 0; // times matching waited for the writer to free a chunk
+};
+
+inline constexpr char TRADE_CHUNK_MAGIC[8] = {'O', 'B', 'T', 'R', 'A', 'D', 'E', '\0'};
+inline constexpr uint32_t TRADE_CHUNK_VERSION = 1;
+
+class TradeStore {
+private:
+    struct ChunkHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t count;
+        uint64_t first; // index of the chunk's first trade
+        int64_t minTime;
+        int64_t maxTime;
+        int32_t minId;
+        int32_t maxId;
+    };
+
+    struct Chunk {
+        std::vector<int64_t> timestamp, price, quantity;
+        std::vector<int32_t> buyId, sellId;
+        std::vector<double> fee;
+        ChunkHeader header{};
+
+        explicit Chunk(size_t n)
+            : timestamp(n), price(n), quantity(n), buyId(n), sellId(n), fee(n) {}
+
+        size_t count() const { return header.count; }
+
+        void reset(uint64_t first) {
+            header.count = 0;
+            header.first = first;
+            header.minTime = std::numeric_limits<int64_t>::max();
+            header.maxTime = std::numeric_limits<int64_t>::min();
+            header.minId = std::numeric_limits<int32_t>::max();
+            header.maxId = std::numeric_limits<int32_t>::min();
+        }
+
+        void append(const StoredTrade& t) {
+            size_t i = header.count++;
+            timestamp[i] = t.timestamp;
+            price[i] = t.price;
+            quantity[i] = t.quantity;
+            buyId[i] = t.buyOrderId;
+            sellId[i] = t.sellOrderId;
+            fee[i] = t.fee;
+            header.minTime = std::min(header.minTime, t.timestamp);
+            header.maxTime = std::max(header.maxTime, t.timestamp);
+            header.minId = std::min({header.minId, t.buyOrderId, t.sellOrderId});
+            header.maxId = std::max({header.maxId, t.buyOrderId, t.sellOrderId});
+        }
+
+        StoredTrade at(size_t i) const {
+            return StoredTrade{timestamp[i], price[i], quantity[i], buyId[i], sellId[i], fee[i]};
+        }
+    };
+
+    struct SpilledChunk {
+        std::string path;
+        ChunkHeader header;
+    };
+
+    struct SpillJob {
+        const Chunk* chunk;
+        uint64_t session;
+    };
+
+    struct SpillResult {
+        SpilledChunk file;
+        bool ok;
+    };
+
+    size_t chunkTrades;
+    size_t chunkBudget; // chunks memory may hold, besides one being spilled
+    OverflowPolicy policy;
+    std::string spillDir;
+    uint64_t session = 0;                        // names this run's spill files
+    std::deque<std::unique_ptr<Chunk>> live;     // oldest first
+    std::deque<std::unique_ptr<Chunk>> inFlight; // handed to the writer, oldest first
+    std::vector<std::unique_ptr<Chunk>> spare;
+    std::vector<SpilledChunk> spilled;           // oldest first
+    std::unique_ptr<Chunk> scratch;              // spilled chunk being read back
+    StoredTrade lastTrade{};
+    PoolStats stats;
+    TradeStoreStats storeStats;
+
+    // Shared with the writer thread, under spillMutex.
+    std::mutex spillMutex;
+    std::condition_variable spillCv;
+    std::deque<SpillJob> spillQueue;
+    std::vector<SpillResult> spillDone;
+    bool stopping = false;
+    std::thread writer;
+
+    static bool writeAll(int fd, const void* data, size_t bytes) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes) {
+            ssize_t n = ::write(fd, p, bytes);
+            if (n <= 0) return false;
+            p += n;
+            bytes -= size_t(n);
+        }
+        return true;
+    }
+
+    static bool readAll(int fd, void* data, size_t bytes) {
+        char* p = static_cast<char*>(data);
+        while (bytes) {
+            ssize_t n = ::read(fd, p, bytes);
+            if (n <= 0) return false;
+            p += n;
+            bytes -= size_t(n);
+        }
+        return true;
+    }
+
+    // Writer thread. Creates a file no earlier run or other store has used.
+    SpillResult spill(const Chunk& chunk, uint64_t fileSession) {
+        ChunkHeader header = chunk.header;
+        std::memcpy(header.magic, TRADE_CHUNK_MAGIC, sizeof(header.magic));
+        header.version = TRADE_CHUNK_VERSION;
+        std::string base = spillDir + "/trades-" + std::to_string(fileSession) + "-" + std::to_string(header.first);
+        std::string path = base + ".col";
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        for (int k = 1; fd < 0 && errno == EEXIST; ++k) {
+            path = base + "-" + std::to_string(k) + ".col";
+            fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+        }
+        if (fd < 0) return {{path, header}, false};
+        size_t n = chunk.count();
+        bool ok = writeAll(fd, &header, sizeof(header)) &&
+                  writeAll(fd, chunk.timestamp.data(), n * sizeof(int64_t)) &&
+                  writeAll(fd, chunk.price.data(), n * sizeof(int64_t)) &&
+                  writeAll(fd, chunk.quantity.data(), n * sizeof(int64_t)) &&
+                  writeAll(fd, chunk.buyId.data(), n * sizeof(int32_t)) &&
+                  writeAll(fd, chunk.sellId.data(), n * sizeof(int32_t)) &&
+                  writeAll(fd, chunk.fee.data(), n * sizeof(double));
+        ::close(fd);
+        return {{path, header}, ok};
+    }
+
+    void runWriter() {
+        std::unique_lock<std::mutex> lock(spillMutex);
+        while (true) {
+            spillCv.wait(lock, [&] { return !spillQueue.empty() || stopping; });
+            if (spillQueue.empty()) return;
+            SpillJob job = spillQueue.front();
+            spillQueue.pop_front();
+            lock.unlock();
+            SpillResult result = spill(*job.chunk, job.session);
+            lock.lock();
+            spillDone.push_back(std::move(result));
+            spillCv.notify_all();
+        }
+    }
+
+    // Matching thread: gives the oldest live chunk to the writer. It stays
+    // queryable in inFlight until collectSpills() sees it written.
+    void handOff() {
+        stats.inUse -= live.front()->count();
+        inFlight.push_back(std::move(live.front()));
+        live.pop_front();
+        {
+            std::lock_guard<std::mutex> lock(spillMutex);
+            spillQueue.push_back({inFlight.back().get(), session});
+        }
+        spillCv.notify_all();
+    }
+
+    // Matching thread: takes back chunks the writer has finished, in order.
+    void collectSpills() {
+        if (inFlight.empty()) return;
+        std::vector<SpillResult> done;
+        {
+            std::lock_guard<std::mutex> lock(spillMutex);
+            done.swap(spillDone);
+        }
+        for (SpillResult& result : done) {
+            std::unique_ptr<Chunk> chunk = std::move(inFlight.front());
+            inFlight.pop_front();
+            if (result.ok) {
+                storeStats.spilled += chunk->count();
+                spilled.push_back(std::move(result.file));
+            } else {
+                storeStats.spillFailures++;
+                stats.overwrites += chunk->count();
+                OB_LOG_ERROR("❌ Cannot spill trades to %s; %u trades dropped", result.file.path, chunk->header.count);
+            }
+            spare.push_back(std::move(chunk));
+        }
+    }
+
+    // Matching thread: blocks until the writer finishes at least one chunk.
+    void waitForSpill() {
+        {
+            std::unique_lock<std::mutex> lock(spillMutex);
+            spillCv.wait(lock, [&] { return !spillDone.empty(); });
+        }
+        collectSpills();
+    }
+
+    static uint64_t newSession() {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::system_clock::now().time_since_epoch())
+                            .count());
+    }
+
+    // Reads a spilled chunk into scratch; false if the file is gone or damaged.
+    bool load(const SpilledChunk& s) {
+        int fd = ::open(s.path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        Chunk& chunk = *scratch;
+        size_t n = s.header.count;
+        bool ok = n <= chunkTrades && readAll(fd, &chunk.header, sizeof(chunk.header)) &&
+                  std::memcmp(chunk.header.magic, TRADE_CHUNK_MAGIC, sizeof(chunk.header.magic)) == 0 &&
+                  chunk.header.count == n &&
+                  readAll(fd, chunk.timestamp.data(), n * sizeof(int64_t)) &&
+                  readAll(fd, chunk.price.data(), n * sizeof(int64_t)) &&
+                  readAll(fd, chunk.quantity.data(), n * sizeof(int64_t)) &&
+                  readAll(fd, chunk.buyId.data(), n * sizeof(int32_t)) &&
+                  readAll(fd, chunk.sellId.data(), n * sizeof(int32_t)) &&
+                  readAll(fd, chunk.fee.data(), n * sizeof(double));
+        ::close(fd);
+        if (!ok) OB_LOG_ERROR("❌ Cannot read spilled trades %s", s.path);
+        return ok;
+    }
+
+    // Makes room for a new chunk at the back; false only under REJECT.
+    bool openChunk() {
+        if (!spillDir.empty()) {
+            collectSpills();
+            if (live.size() >= chunkBudget) handOff();
+            if (spare.empty()) {
+                storeStats.spillWaits++;
+                waitForSpill();
+            }
+        } else if (spare.empty()) {
+            if (policy == OverflowPolicy::GROW) {
+                spare.push_back(std::make_unique<Chunk>(chunkTrades));
+                stats.capacity += chunkTrades;
+                stats.grows++;
+            } else if (policy == OverflowPolicy::OVERWRITE && !live.empty()) {
+                stats.overwrites += live.front()->count();
+                stats.inUse -= live.front()->count();
+                spare.push_back(std::move(live.front()));
+                live.pop_front();
+            } else {
+                return false;
+            }
+        }
+        live.push_back(std::move(spare.back()));
+        spare.pop_back();
+        live.back()->reset(storeStats.recorded);
+        return true;
+    }
+
+    // Visits spilled chunks then live ones, oldest first, skipping those whose
+    // header rules them out; row(chunk, i) picks the trades to pass to f.
+    template <typename ChunkFilter, typename RowFilter, typename F>
+    void scan(ChunkFilter&& keep, RowFilter&& row, F&& f) {
+        auto visit = [&](const Chunk& chunk) {
+            for (size_t i = 0; i < chunk.count(); ++i) {
+                if (row(chunk, i)) f(chunk.at(i));
+            }
+        };
+        collectSpills();
+        for (const SpilledChunk& s : spilled) {
+            if (keep(s.header) && load(s)) visit(*scratch);
+        }
+        for (const auto& chunk : inFlight) {
+            if (keep(chunk->header)) visit(*chunk);
+        }
+        for (const auto& chunk : live) {
+            if (keep(chunk->header)) visit(*chunk);
+        }
+    }
+
+public:
+    explicit TradeStore(size_t capacity = 1 << 16, OverflowPolicy policy_ = OverflowPolicy::GROW,
+                        std::string spillDir_ = {}, size_t chunkTrades_ = 4096)
+        : chunkTrades(std::max<size_t>(1, std::min(chunkTrades_, std::max<size_t>(capacity, 1)))),
+          chunkBudget(std::max<size_t>(1, (capacity + chunkTrades - 1) / chunkTrades)),
+          policy(policy_),
+          spillDir(std::move(spillDir_)),
+          scratch(std::make_unique<Chunk>(chunkTrades)) {
+        size_t chunks = chunkBudget + (spillDir.empty() ? 0 : 1);
+        for (size_t i = 0; i < chunks; ++i) spare.push_back(std::make_unique<Chunk>(chunkTrades));
+        stats.capacity = chunkBudget * chunkTrades;
+        if (!spillDir.empty()) {
+            session = newSession();
+            writer = std::thread([this] { runWriter(); });
+        }
+    }
+
+    // Finishes the spills in flight first.
+    ~TradeStore() {
+        if (!writer.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(spillMutex);
+            stopping = true;
+        }
+        spillCv.notify_all();
+        writer.join();
+    }
+
+    TradeStore(const TradeStore&) = delete;
+    TradeStore& operator=(const TradeStore&) = delete;
+
+    // False if the trade could not be recorded (REJECT with memory full).
+    bool push_back(const StoredTrade& trade) {
+        if ((live.empty() || live.back()->count() == chunkTrades) && !openChunk()) {
+            stats.rejects++;
+            return false;
+        }
+        live.back()->append(trade);
+        lastTrade = trade;
+        storeStats.recorded++;
+        if (++stats.inUse > stats.highWater) stats.highWater = stats.inUse;
+        return true;
+    }
+
+    // Nothing recorded yet. back() is the latest trade even once spilled.
+    bool empty() const { return storeStats.recorded == 0; }
+    const StoredTrade& back() const { return lastTrade; }
+    size_t inMemory() const { return stats.inUse; }
+
+    // Forgets everything in memory and the list of spill files (the files stay;
+    // later spills start a new session, so they do not replace them).
+    void clear() {
+        while (!inFlight.empty()) waitForSpill();
+        if (!spillDir.empty()) session = newSession();
+        while (!live.empty()) {
+            spare.push_back(std::move(live.back()));
+            live.pop_back();
+        }
+        spilled.clear();
+        stats.inUse = 0;
+        storeStats = {};
+    }
+
+    // Every retained trade, oldest first.
+    template <typename F>
+    void forEach(F&& f) {
+        scan([](const ChunkHeader&) { return true; }, [](const Chunk&, size_t) { return true; }, f);
+    }
+
+    // Trades with from <= timestamp < to (ns since the Unix epoch).
+    template <typename F>
+    void forEachInTimeRange(int64_t from, int64_t to, F&& f) {
+        scan([&](const ChunkHeader& h) { return h.count && h.maxTime >= from && h.minTime < to; },
+             [&](const Chunk& c, size_t i) { return c.timestamp[i] >= from && c.timestamp[i] < to; }, f);
+    }
+
+    // Trades where orderId was the buyer or the seller.
+    template <typename F>
+    void forEachForOrder(int32_t orderId, F&& f) {
+        scan([&](const ChunkHeader& h) { return h.count && h.minId <= orderId && orderId <= h.maxId; },
+             [&](const Chunk& c, size_t i) { return c.buyId[i] == orderId || c.sellId[i] == orderId; }, f);
+    }
+
+    const PoolStats& getStats() const { return stats; }
+    const TradeStoreStats& getStoreStats() const { return storeStats; }
+    size_t spilledChunks() const { return spilled.size(); }
+};
+
+#endif